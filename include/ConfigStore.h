@@ -0,0 +1,51 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @class ConfigStore
+ * @brief Penyimpanan konfigurasi persisten di EEPROM, per slot
+ *
+ * Setiap slot punya alamat tetap dan record sendiri:
+ * [magic][panjang][data...][checksum]. Slot yang kosong, rusak, atau
+ * panjangnya berbeda (struct berubah) dianggap tidak ada, sehingga
+ * pemanggil kembali ke default. Penulisan memakai EEPROM.update() agar
+ * byte yang sama tidak ditulis ulang (umur EEPROM).
+ */
+class ConfigStore {
+public:
+    enum class Slot : uint8_t {
+        CSV_SCHEMA,     // Generic Fixed CSV column -> channel map
+        ECU_BAUD,       // ECU link rate found by autodetect
+        COUNT
+    };
+
+    template <typename T>
+    static bool load(Slot slot, T &out) {
+        static_assert(sizeof(T) <= MAX_RECORD_DATA, "record too large for its slot");
+        return read_(slot, &out, (uint8_t)sizeof(T));
+    }
+
+    template <typename T>
+    static void save(Slot slot, const T &value) {
+        static_assert(sizeof(T) <= MAX_RECORD_DATA, "record too large for its slot");
+        write_(slot, &value, (uint8_t)sizeof(T));
+    }
+
+    // Forget a slot (next load() fails, caller falls back to defaults)
+    static void erase(Slot slot);
+
+private:
+    static constexpr uint8_t MAGIC = 0xC5;
+    static constexpr uint8_t SLOT_SIZE = 40;    // bytes reserved per slot
+    static constexpr uint8_t MAX_RECORD_DATA = SLOT_SIZE - 3;
+
+    static uint16_t address_(Slot slot) { return (uint16_t)slot * SLOT_SIZE; }
+    static uint8_t checksum_(const uint8_t *data, uint8_t len);
+    static bool read_(Slot slot, void *data, uint8_t len);
+    static void write_(Slot slot, const void *data, uint8_t len);
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @class Crc32
+ * @brief CRC32 (IEEE 802.3, reflected 0xEDB88320) table-driven untuk AVR
+ *
+ * Dipakai untuk memvalidasi envelope protokol serial Speeduino baru
+ * (length + payload + CRC32). Tabel 256 x uint32_t (1 KB) di PROGMEM,
+ * dihitung saat compile; satu lookup per byte (~30 cycle di ATmega).
+ */
+class Crc32 {
+public:
+    static constexpr uint32_t INIT = 0xFFFFFFFFUL;
+    static constexpr uint32_t POLY = 0xEDB88320UL;
+
+    struct Table {
+        uint32_t v[256];
+        constexpr Table() : v() {
+            for (uint16_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (uint8_t k = 0; k < 8; ++k) {
+                    c = (c & 1) ? (POLY ^ (c >> 1)) : (c >> 1);
+                }
+                v[i] = c;
+            }
+        }
+    };
+
+    static uint32_t update(uint32_t crc, uint8_t b) {
+        return (crc >> 8) ^ pgm_read_dword(&TABLE.v[(uint8_t)(crc ^ b)]);
+    }
+    static uint32_t finish(uint32_t crc) { return ~crc; }
+
+    // One-shot over a contiguous buffer
+    static uint32_t compute(const uint8_t *data, uint16_t len);
+
+private:
+    static const Table TABLE;
+};
+
+#endif
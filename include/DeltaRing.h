@@ -0,0 +1,128 @@
+#ifndef DELTA_RING_H
+#define DELTA_RING_H
+
+#include <stdint.h>
+
+/**
+ * @class DeltaRing
+ * @brief Ring history satu channel, delta + zig-zag varint (tanpa alokasi)
+ *
+ * Sampel tertua disimpan absolut (base_), sisanya sebagai selisih terhadap
+ * sampel sebelumnya: zig-zag (selisih kecil +/- jadi angka kecil) lalu varint
+ * 7-bit (1 byte untuk |delta| < 64, maks 3 byte). Sinyal mesin yang berubah
+ * pelan kebanyakan muat 1 byte per sampel.
+ *
+ * append() O(1): bila ruang tidak cukup, sampel tertua dibuang (paling banyak
+ * 3, satu varint baru <= 3 byte). Iterasi dari tertua ke terbaru dengan
+ * begin()/end() (range-for). Header-only, tanpa Arduino.
+ */
+template <uint16_t Bytes>
+class DeltaRing {
+    static_assert(Bytes >= 4 && Bytes <= 32768, "DeltaRing size must be 4..32768 bytes");
+
+public:
+    static constexpr uint8_t MAX_VARINT = 3;  // 16-bit delta -> <= 17 bits zig-zag
+
+    void clear() { head_ = tail_ = used_ = 0; count_ = 0; }
+
+    void append(int16_t v) {
+        if (count_ == 0) {
+            base_ = newest_ = v;
+            count_ = 1;
+            return;
+        }
+        uint32_t z = zigzag_((int32_t)v - newest_);
+        uint8_t need = varintSize_(z);
+        while ((uint16_t)(Bytes - used_) < need) dropOldest_();
+        while (z >= 0x80) {
+            put_((uint8_t)(z | 0x80));
+            z >>= 7;
+        }
+        put_((uint8_t)z);
+        newest_ = v;
+        count_++;  // <= Bytes + 1: every delta takes at least one byte
+    }
+
+    uint16_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    uint16_t bytesUsed() const { return used_; }
+    int16_t newest() const { return newest_; }
+    int16_t oldest() const { return base_; }
+
+    // Forward iterator, oldest -> newest
+    class Iterator {
+    public:
+        int16_t operator*() const { return value_; }
+        Iterator &operator++() {
+            if (--left_) value_ = (int16_t)(value_ + ring_->readDelta_(pos_));
+            return *this;
+        }
+        bool operator!=(const Iterator &o) const { return left_ != o.left_; }
+        uint16_t remaining() const { return left_; }
+
+    private:
+        friend class DeltaRing;
+        Iterator(const DeltaRing *r, uint16_t pos, uint16_t left, int16_t v)
+            : ring_(r), pos_(pos), left_(left), value_(v) {}
+        const DeltaRing *ring_;
+        uint16_t pos_;
+        uint16_t left_;
+        int16_t value_;
+    };
+
+    Iterator begin() const { return Iterator(this, tail_, count_, base_); }
+    Iterator end() const { return Iterator(this, tail_, 0, 0); }
+
+    // Iterator positioned at the n-th newest sample (for trend windows)
+    Iterator last(uint16_t n) const {
+        Iterator it = begin();
+        while (it.remaining() > n) ++it;
+        return it;
+    }
+
+private:
+    static uint32_t zigzag_(int32_t d) { return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31); }
+    static int32_t unzigzag_(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1); }
+    static uint8_t varintSize_(uint32_t z) { return z < 0x80 ? 1 : (z < 0x4000 ? 2 : 3); }
+
+    void put_(uint8_t b) {
+        buf_[head_] = b;
+        head_ = next_(head_);
+        used_++;
+    }
+
+    static uint16_t next_(uint16_t i) { return (uint16_t)(i + 1 == Bytes ? 0 : i + 1); }
+
+    // Decode one varint at pos (advanced past it)
+    int32_t readDelta_(uint16_t &pos) const {
+        uint32_t z = 0;
+        uint8_t shift = 0;
+        uint8_t b;
+        do {
+            b = buf_[pos];
+            pos = next_(pos);
+            z |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        return unzigzag_(z);
+    }
+
+    // Fold the second-oldest delta into base_ and release its bytes
+    void dropOldest_() {
+        uint16_t pos = tail_;
+        base_ = (int16_t)(base_ + readDelta_(pos));
+        used_ = (uint16_t)(used_ - (pos + Bytes - tail_) % Bytes);  // 1..3 bytes
+        tail_ = pos;
+        count_--;
+    }
+
+    uint8_t buf_[Bytes];
+    uint16_t head_ = 0;
+    uint16_t tail_ = 0;
+    uint16_t used_ = 0;
+    uint16_t count_ = 0;
+    int16_t base_ = 0;
+    int16_t newest_ = 0;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef DERIVED_CHANNELS_H
+#define DERIVED_CHANNELS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "ECUData.h"
+
+/**
+ * @class DerivedChannels
+ * @brief Channel turunan (duty injektor, fuel flow, lambda, liter terpakai), lazy
+ *
+ * Setiap nilai turunan punya mask channel input. observe() dipanggil sekali
+ * per frame: nilai yang inputnya berubah ditandai stale, dan integrator
+ * bahan bakar ditambah pw * rpm * dt (tanpa pembagian). get() menghitung
+ * ulang hanya nilai stale yang benar-benar dibaca; sisanya dari cache.
+ *
+ * PW1 adalah channel extended: pemakai harus subscribe requiredChannels().
+ */
+class DerivedChannels {
+public:
+    enum class Id : uint8_t {
+        INJ_DUTY,       // injector duty [0.1 %]
+        FUEL_FLOW,      // fuel flow [0.01 L/h]
+        LAMBDA,         // lambda [0.001]
+        FUEL_USED,      // fuel used since reset [0.01 L]
+        COUNT
+    };
+
+    struct Config {
+        uint16_t injector_cc_min;    // injector flow [cc/min] per injector
+        uint8_t injectors;           // number of injectors
+        uint8_t squirts_per_cycle;   // injections per 720 deg per injector
+        uint16_t dead_time_us;       // opening time included in PW1
+        uint16_t stoich_x100;        // stoichiometric AFR [1470 = petrol]
+    };
+
+    static constexpr ECUData::ChannelMask inputs(Id id) {
+        return id == Id::LAMBDA ? ECUData::channelBit(ECUData::Channel::AFR)
+             : ECUData::channelBit(ECUData::Channel::PW1) | ECUData::channelBit(ECUData::Channel::RPM);
+    }
+    static constexpr ECUData::ChannelMask requiredChannels() {
+        return inputs(Id::INJ_DUTY) | inputs(Id::LAMBDA);
+    }
+
+    DerivedChannels();
+
+    void setConfig(const Config &config);
+    const Config& getConfig() const { return config_; }
+
+    // Once per published frame
+    void observe(const ECUData &ecu_data);
+
+    // Cached value, recomputed here only if an input changed since last read
+    int32_t get(Id id);
+
+    void resetFuelUsed();
+    // Engine-running time since reset that FUEL_USED does not cover (frame
+    // gaps beyond MAX_STEP_MS); non-zero means the total is a lower bound
+    uint32_t getFuelGapMs() const { return fuel_gap_ms_; }
+    uint16_t getEvaluations() const { return evaluations_; }
+
+private:
+    static constexpr uint8_t COUNT = (uint8_t)Id::COUNT;
+    static constexpr uint16_t MAX_STEP_MS = 1000;  // longer gaps: capped, excess counted
+
+    Config config_;
+    uint8_t stale_;                 // bit per Id
+    int32_t cache_[COUNT];
+    uint16_t evaluations_;
+
+    // Inputs as of the last observe()
+    uint16_t pw_us_;
+    uint16_t rpm_;
+    uint16_t afr_x100_;
+
+    // Fuel integrator: sum of effective_pw_us * rpm * dt_ms
+    uint64_t fuel_acc_;
+    uint32_t fuel_gap_ms_;
+    uint32_t last_observe_ms_;
+
+    uint16_t effectivePw_() const;
+    int32_t compute_(Id id) const;
+};
+
+#endif
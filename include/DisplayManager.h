@@ -72,6 +72,7 @@ public:
     void setFont(const GFXfont *font = nullptr); // nullptr = built-in font
     void setCursor(int16_t x, int16_t y);
     void print(const char *text);
+    void print(const __FlashStringHelper *text);  // F("..."): literal stays in flash
     void printf(const char *format, ...);
     
     // Centered text helpers
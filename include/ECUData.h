@@ -3,6 +3,18 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "PackedValue.h"
+
+// Packed fixed-point layout: 1-byte storage for temperatures, TPS, AFR and
+// battery, bit-field status flags. Default on for the Uno (2 KB SRAM);
+// override with -DECU_COMPACT_DATA=0/1.
+#ifndef ECU_COMPACT_DATA
+#if defined(__AVR_ATmega328P__)
+#define ECU_COMPACT_DATA 1
+#else
+#define ECU_COMPACT_DATA 0
+#endif
+#endif
 
 /**
  * @class ECUData
@@ -13,26 +25,129 @@
  */
 class ECUData {
 public:
+    // Channel identities (bit index in ChannelMask)
+    enum class Channel : uint8_t {
+        RPM,
+        MAP,
+        TPS,
+        CLT,
+        IAT,
+        AFR,
+        BATTERY,
+        // Extended realtime block channels (decoded only when subscribed)
+        ADVANCE,
+        VE,
+        AFR_TARGET,
+        PW1,
+        TAE,
+        CORRECTIONS,
+        EGO,
+        BARO,
+        BOOST_TARGET,
+        BOOST_DUTY,
+        FLEX,
+        RPM_DOT,
+        AFR2,
+        TPS_DOT,
+        VSS,
+        GEAR,
+        COUNT
+    };
+    typedef uint32_t ChannelMask;
+    static constexpr ChannelMask channelBit(Channel ch) { return (ChannelMask)1 << (uint8_t)ch; }
+    static constexpr ChannelMask CORE_CHANNELS = 0x7F;  // RPM..BATTERY
+    static constexpr ChannelMask EXTENDED_CHANNELS =
+        (((ChannelMask)1 << (uint8_t)Channel::COUNT) - 1) & ~CORE_CHANNELS;
+    static_assert((uint8_t)Channel::COUNT <= 32, "ChannelMask holds 32 channels");
+
+    // Storage per channel kind. Compact: values read back in the same units,
+    // quantized to the step shown (clamped outside the range).
+#if ECU_COMPACT_DATA
+    typedef pack::Value<uint8_t, int16_t, 1, -40> Temperature;  // -40..215 °C
+    typedef pack::Value<uint8_t, uint16_t> Percent;              // 0..255
+    typedef pack::Value<uint8_t, uint16_t, 10> AfrX100;          // step 0.1, max 25.5
+    typedef pack::Value<uint8_t, uint16_t, 100> MilliVolts;      // step 0.1 V, max 25.5 V
+    typedef pack::Value<uint8_t, uint16_t, 2> KpaByTwo;          // step 2 kPa, max 510
+    typedef pack::Value<uint8_t, uint16_t> Speed;                // 0..255 km/h
+#else
+    typedef int16_t Temperature;
+    typedef uint16_t Percent;
+    typedef uint16_t AfrX100;
+    typedef uint16_t MilliVolts;
+    typedef uint16_t KpaByTwo;
+    typedef uint16_t Speed;
+#endif
+
     // Engine State Parameters
     uint16_t rpm;           // RPM [0..8000+]
-    int16_t clt;            // Coolant Temperature [°C, -40..120]
-    uint16_t afr;           // Air-Fuel Ratio [100x, e.g., 1400 = 14.00:1]
-    uint16_t map;           // Manifold Absolute Pressure [kPa, 0..255]
-    uint16_t tps;           // Throttle Position Sensor [0..100%]
-    int16_t iat;            // Intake Air Temperature [°C, -40..120]
-    uint16_t battery;       // Battery Voltage [mV, 0..16000]
+    Temperature clt;        // Coolant Temperature [°C, -40..120]
+    AfrX100 afr;            // Air-Fuel Ratio [100x, e.g., 1400 = 14.00:1]
+    uint16_t map;           // Manifold Absolute Pressure [kPa, 0..511]
+    Percent tps;            // Throttle Position Sensor [0..100%]
+    Temperature iat;        // Intake Air Temperature [°C, -40..120]
+    MilliVolts battery;     // Battery Voltage [mV, 0..16000]
+
+    // Extended Parameters (valid only while subscribed)
+    int8_t advance;         // Ignition advance [deg BTDC]
+    uint8_t ve;             // Current VE [%]
+    uint8_t afrTarget;      // Target AFR [10x, e.g., 147 = 14.7:1]
+    uint8_t afr2;           // Second O2 sensor AFR [10x]
+    uint16_t pw1;           // Injector pulse width bank 1 [us]
+    uint8_t tae;            // Acceleration enrichment [%]
+    uint8_t corrections;    // Total fuel correction [%]
+    uint8_t ego;            // Closed-loop O2 correction [%]
+    uint8_t baro;           // Barometric pressure [kPa]
+    KpaByTwo boostTarget;   // Boost target [kPa]
+    uint8_t boostDuty;      // Boost solenoid duty [%]
+    uint8_t flex;           // Ethanol content [%]
+    int16_t rpmDot;         // RPM rate of change [rpm/s]
+    uint16_t tpsDot;        // TPS rate of change [%/s]
+    Speed vss;              // Vehicle speed [km/h]
+    uint8_t gear;           // Current gear [0 = neutral]
     
     // Sync Status
     uint16_t syncLossCounter;  // Total sync loss events
-    bool isSynced;             // Current sync status
     
     // Timestamp & Health
     uint32_t lastUpdateMillis; // Last successful frame received
+#if ECU_COMPACT_DATA
+    bool isSynced : 1;         // Current sync status
+    bool isDataValid : 1;      // Data still within timeout window
+#else
+    bool isSynced;             // Current sync status
     bool isDataValid;          // Data still within timeout window
+#endif
     
     // Constructor
     ECUData();
+
+    // Consumers (UI cell, logger, alarm) subscribe to the extended channels
+    // they read; core channels are always decoded
+    void subscribe(ChannelMask channels) { subscriptions_ |= channels; }
+    void unsubscribe(ChannelMask channels) { subscriptions_ &= ~channels; }
+    ChannelMask subscriptions() const { return subscriptions_; }
+    bool isSubscribed(Channel ch) const { return (subscriptions_ & channelBit(ch)) != 0; }
+
+    // Change mask: bit set when the parser stored a raw value that differs
+    // from the previous one. Accumulates across frames until the loop clears
+    // it after all consumers (sync, smoothing, render) have run.
+    ChannelMask changedChannels() const { return changed_; }
+    bool hasChanged(ChannelMask channels) const { return (changed_ & channels) != 0; }
+    void clearChanged(ChannelMask channels = ~(ChannelMask)0) { changed_ &= ~channels; }
+
+    // Store a channel value, flagging it only when the stored value differs
+    // (compact layout: differs at the packed resolution)
+    template <typename T, typename V>
+    void store(Channel ch, T ECUData::*member, V value) {
+        T v = (T)value;
+        if (this->*member == v) return;
+        this->*member = v;
+        changed_ |= channelBit(ch);
+    }
     
+    // Any channel as a plain integer in its ECUData units (table-driven consumers)
+    int32_t value(Channel ch) const;
+
     // Reset data to default/safe state
     void reset();
     
@@ -41,6 +156,12 @@ public:
     
     // Print debug info to Serial
     void debugPrint() const;
+
+private:
+    friend class ECUSnapshot;  // carries change bits across published frames
+
+    ChannelMask subscriptions_ = 0;
+    ChannelMask changed_ = 0;
 };
 
 #endif
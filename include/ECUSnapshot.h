@@ -0,0 +1,76 @@
+#ifndef ECU_SNAPSHOT_H
+#define ECU_SNAPSHOT_H
+
+#include <stdint.h>
+#include "ECUData.h"
+
+/**
+ * @class ECUSnapshot
+ * @brief Double buffer ECUData dengan sequence counter (seqlock), single-writer
+ *
+ * Producer (parser; kelak ISR/task terpisah) mendekode ke salinan kerjanya
+ * sendiri lalu publish() frame yang sudah lengkap ke buffer yang tidak sedang
+ * dipublikasikan, kemudian menaikkan seq_. Consumer (SyncManager/UIScreen)
+ * menyalin buffer seq_ & 1 dan mengulang bila seq_ berubah selama penyalinan.
+ * Writer tidak pernah menunggu dan tidak ada cli() selama penyalinan; seq_
+ * dan ack_ 8-bit sehingga atomik di AVR.
+ *
+ * Change mask: writer menggabungkan bit yang berubah sejak snapshot terakhir
+ * yang sudah dibaca consumer (ack_), jadi tidak ada bit yang hilang walaupun
+ * beberapa frame dipublikasikan di antara dua pembacaan.
+ */
+class ECUSnapshot {
+public:
+    // Producer side. Clears the working copy's change mask once published.
+    void publish(ECUData &work) {
+        uint8_t s = seq_;
+        barrier_();
+        if (ack_ == s) carried_ = 0;  // consumer took everything up to s
+        carried_ |= work.changed_;
+        ECUData &back = buf_[(uint8_t)(s + 1) & 1];
+        back = work;
+        back.changed_ = carried_;
+        work.changed_ = 0;
+        barrier_();
+        seq_ = (uint8_t)(s + 1);
+    }
+
+    // Consumer side. Copies the latest complete frame into out, keeping
+    // change bits out has not cleared yet and out's own subscriptions
+    // (the producer decodes by its working copy's). Returns false when nothing was
+    // published since the previous read (out untouched). A copy is retried
+    // when the writer published during it; the writer never blocks, so with
+    // frames milliseconds apart this settles on the next attempt.
+    bool read(ECUData &out) {
+        ECUData::ChannelMask unseen = out.changed_;
+        ECUData::ChannelMask subscribed = out.subscriptions_;
+        uint8_t s;
+        for (;;) {
+            s = seq_;
+            barrier_();
+            if (s == ack_) return false;
+            out = buf_[s & 1];
+            barrier_();
+            if (seq_ == s) break;
+            if (retries_ != 0xFFFF) retries_++;
+        }
+        out.changed_ |= unseen;
+        out.subscriptions_ = subscribed;
+        ack_ = s;
+        return true;
+    }
+
+    uint8_t sequence() const { return seq_; }
+    uint16_t retries() const { return retries_; }
+
+private:
+    static inline void barrier_() { __asm__ __volatile__("" ::: "memory"); }
+
+    ECUData buf_[2];
+    ECUData::ChannelMask carried_ = 0;  // writer only
+    volatile uint8_t seq_ = 0;          // written by producer
+    volatile uint8_t ack_ = 0;          // written by consumer
+    uint16_t retries_ = 0;              // torn copies, consumer only
+};
+
+#endif
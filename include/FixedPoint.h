@@ -0,0 +1,77 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Scanner angka desimal ASCII ke fixed-point (tanpa float, tanpa Arduino)
+ *
+ * Dipakai bersama oleh decoder CSV dan key=value. Satu kali lewat per field:
+ * bagian bulat dan 3 digit pecahan pertama dikumpulkan sebagai integer,
+ * lalu diskalakan ke representasi ECUData (AFR x100, baterai mV) dengan
+ * pembagian 16-bit kecil. Header-only agar bisa diuji/benchmark di host.
+ */
+namespace fixp {
+
+struct Decimal {
+    int32_t whole;      // integer part (sign applied)
+    uint16_t milli;     // first three fractional digits, 0..999 (unsigned)
+    bool neg;
+    bool valid;         // at least one digit seen
+};
+
+// Scan one number starting at s (leading blanks and sign allowed).
+// Stops at the first character that is not part of the number and
+// returns a pointer to it. Extra fractional digits are skipped.
+inline const char *scan(const char *s, Decimal &out) {
+    out.whole = 0;
+    out.milli = 0;
+    out.neg = false;
+    out.valid = false;
+    while (*s == ' ' || *s == '\t') s++;
+    if (*s == '-') { out.neg = true; s++; }
+    else if (*s == '+') s++;
+    int32_t w = 0;
+    while (*s >= '0' && *s <= '9') {
+        w = w * 10 + (*s - '0');
+        out.valid = true;
+        s++;
+    }
+    if (*s == '.') {
+        s++;
+        uint16_t scale = 100;
+        while (*s >= '0' && *s <= '9') {
+            if (scale) {
+                out.milli = (uint16_t)(out.milli + (uint8_t)(*s - '0') * scale);
+                scale /= 10;
+            }
+            out.valid = true;
+            s++;
+        }
+    }
+    out.whole = out.neg ? -w : w;
+    return s;
+}
+
+// Value in units of 1/Unit (Unit divides 1000), rounded half up on magnitude.
+template <uint16_t Unit>
+inline int32_t scaled(const Decimal &d) {
+    static_assert(Unit > 0 && 1000 % Unit == 0, "Unit must divide 1000");
+    uint16_t frac;
+    if constexpr (Unit == 1000) frac = d.milli;
+    else if constexpr (Unit == 1) frac = 0;
+    else frac = (uint16_t)((d.milli + 500 / Unit) / (1000 / Unit));
+    int32_t v = d.whole * (int32_t)Unit;
+    return d.neg ? v - frac : v + frac;
+}
+
+// Value is strictly between 0 and limit (whole units)
+inline bool inOpenRange(const Decimal &d, int32_t limit) {
+    if (!d.valid || d.neg) return false;
+    if (d.whole == 0) return d.milli != 0;
+    return d.whole < limit;
+}
+
+}  // namespace fixp
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "ECUData.h"
+#include "DeltaRing.h"
+
+// Bytes per recorded channel (0 = history compiled out). Mega: 4 x 384 B,
+// under a fifth of its 8 KB SRAM. At 2 Hz, measured on a simulated city
+// drive: RPM ~2.3 min (gear changes cost 2-byte deltas), MAP/CLT/AFR
+// ~3.2 min (1 byte/sample). Raise only after checking avr-size.
+#ifndef ECU_HISTORY_BYTES
+#if defined(__AVR_ATmega328P__)
+#define ECU_HISTORY_BYTES 0
+#else
+#define ECU_HISTORY_BYTES 384
+#endif
+#endif
+
+#ifndef ECU_HISTORY_PERIOD_MS
+#define ECU_HISTORY_PERIOD_MS 500
+#endif
+
+// No frame for this long: the link dropped, stop recording the frozen value
+#ifndef ECU_HISTORY_STALE_MS
+#define ECU_HISTORY_STALE_MS 500
+#endif
+
+/**
+ * @class SessionHistory
+ * @brief Riwayat sampel terbaru RPM/MAP/CLT/AFR di SRAM (ring terkompresi)
+ *
+ * Satu DeltaRing per channel, disampel setiap ECU_HISTORY_PERIOD_MS selama
+ * data valid dan segar. Jeda data lebih dari ECU_HISTORY_STALE_MS tidak
+ * direkam (nilai beku tidak diulang); posisi dan panjang jeda dicatat di
+ * daftar gap kecil, sehingga ageMs() dan exportCsv() memberi waktu yang
+ * benar untuk sampel sebelum jeda. Widget trend membaca ring(ch) lewat
+ * iterator dan ageMs(); exportCsv() mengirim seluruh riwayat (tertua dulu).
+ */
+class SessionHistory {
+public:
+    static constexpr uint8_t CHANNELS = 4;
+    typedef DeltaRing<(ECU_HISTORY_BYTES > 0 ? ECU_HISTORY_BYTES : 4)> Ring;
+
+    // Recorded channels, in ring order
+    static constexpr ECUData::ChannelMask recordedChannels() {
+        return ECUData::channelBit(ECUData::Channel::RPM) |
+               ECUData::channelBit(ECUData::Channel::MAP) |
+               ECUData::channelBit(ECUData::Channel::CLT) |
+               ECUData::channelBit(ECUData::Channel::AFR);
+    }
+
+    // Call every loop; records at most one sample per period
+    void update(const ECUData &ecu_data);
+
+    void clear();
+
+    // Ring of a recorded channel, nullptr for any other channel
+    const Ring *ring(ECUData::Channel ch) const;
+    uint16_t periodMs() const { return ECU_HISTORY_PERIOD_MS; }
+
+    // Age of the sample `back` places before the newest (0 = newest) in ms,
+    // dropouts included; -1 if it predates the oldest gap still tracked.
+    // Two neighbours more than periodMs() apart straddle a dropout.
+    int32_t ageMs(uint16_t back) const;
+
+    // "t_ms,rpm,map,clt,afr" rows, oldest first; t relative to the newest sample
+    void exportCsv(Print &out) const;
+
+private:
+#if ECU_HISTORY_BYTES > 0
+    // Dropout before sample number seq (count of samples recorded before it)
+    struct Gap {
+        uint32_t seq;
+        uint16_t periods;  // sample periods missing
+    };
+    static constexpr uint8_t MAX_GAPS = 16;
+
+    Ring rings_[CHANNELS];
+    uint32_t last_sample_ms_ = 0;
+    uint32_t seq_ = 0;            // samples recorded since clear()
+    uint32_t timed_from_ = 0;     // older samples lost their gap record
+    Gap gaps_[MAX_GAPS];          // oldest first
+    uint8_t gap_count_ = 0;
+
+    void noteGap_(uint16_t periods);
+#endif
+
+    static int8_t slot_(ECUData::Channel ch);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef LINK_QUALITY_H
+#define LINK_QUALITY_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @class LinkQuality
+ * @brief Estimasi kualitas link ECU: EWMA interval frame, jitter dan error rate
+ *
+ * Diisi parser dengan timestamp setiap frame valid (onFrame) dan setiap frame
+ * yang ditolak (onError). Semua EWMA integer (shift): interval dan jitter
+ * alpha 1/8 dalam ms x16, error rate alpha 1/16 sebagai fraksi Q16. Dari sini
+ * SyncManager menurunkan timeout NO_DATA yang mengikuti kecepatan link,
+ * SYNC_LOSS saat error rate tinggi, dan lama RECOVERY.
+ */
+class LinkQuality {
+public:
+    static constexpr uint8_t MIN_FRAMES = 4;         // before the estimates count
+    static constexpr uint8_t HEALTHY_ERROR_PCT = 10; // at or below: healthy
+
+    LinkQuality() { reset(); }
+
+    void reset();
+
+    void onFrame(uint32_t now_ms);
+    void onError();
+
+    uint16_t intervalMs() const { return (uint16_t)((interval_x16_ + 8) >> 4); }
+    uint16_t jitterMs() const { return (uint16_t)((jitter_x16_ + 8) >> 4); }
+    uint16_t frameRateX10() const;                    // frames per 10 s
+    uint8_t errorPercent() const { return (uint8_t)(((uint32_t)error_q16_ * 100 + 32768) >> 16); }
+    uint32_t lastFrameMs() const { return last_frame_ms_; }
+    bool hasEstimate() const { return frames_ >= MIN_FRAMES; }
+
+    // No-frame timeout for this link: 2 intervals + 4 jitter, at least floor_ms
+    uint32_t timeoutMs(uint32_t floor_ms) const;
+    // Enough frames and a low error rate
+    bool isHealthy() const { return hasEstimate() && errorPercent() <= HEALTHY_ERROR_PCT; }
+
+    void debugPrint() const;
+
+private:
+    uint32_t last_frame_ms_;
+    uint16_t interval_x16_;   // EWMA inter-frame interval [ms x16]
+    uint16_t jitter_x16_;     // EWMA |interval - mean| [ms x16]
+    uint16_t error_q16_;      // EWMA of rejected/total events [Q16]
+    uint8_t frames_;          // good frames since reset (saturating)
+
+    void error_(bool failed);
+};
+
+#endif
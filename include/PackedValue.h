@@ -0,0 +1,49 @@
+#ifndef PACKED_VALUE_H
+#define PACKED_VALUE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Penyimpanan fixed-point ringkas untuk member ECUData (build Uno)
+ *
+ * pack::Value<Raw, T, Div, Offset> menyimpan (v - Offset) / Div dalam Raw
+ * (unsigned, biasanya 1 byte) tetapi dibaca/ditulis sebagai T dalam satuan
+ * aslinya, sehingga kode yang memakai ecu.clt, ecu.battery, dst. tidak
+ * berubah. Nilai di luar jangkauan di-clamp; pembulatan ke satuan Div terdekat.
+ * Header-only, tanpa Arduino.
+ */
+namespace pack {
+
+template <typename Raw, typename T, uint8_t Div = 1, int16_t Offset = 0>
+class Value {
+    static_assert((Raw)-1 > 0, "raw storage must be unsigned");
+    static_assert(sizeof(Raw) < sizeof(int32_t), "raw storage wider than the encoder");
+    static_assert(Div > 0, "divisor must be non-zero");
+
+public:
+    typedef T value_type;
+    static constexpr int32_t RAW_MAX = (int32_t)(Raw)-1;
+    static constexpr int32_t MIN = Offset;
+    static constexpr int32_t MAX = RAW_MAX * Div + Offset;
+
+    constexpr Value() : raw_(encode_(0)) {}
+    constexpr Value(T v) : raw_(encode_(v)) {}
+
+    Value &operator=(T v) { raw_ = encode_(v); return *this; }
+    operator T() const { return (T)((int32_t)raw_ * Div + Offset); }
+
+    Raw raw() const { return raw_; }
+
+private:
+    static constexpr Raw encode_(int32_t v) {
+        return v <= MIN ? (Raw)0
+             : v >= MAX ? (Raw)RAW_MAX
+             : (Raw)((v - Offset + Div / 2) / Div);
+    }
+
+    Raw raw_;
+};
+
+}  // namespace pack
+
+#endif
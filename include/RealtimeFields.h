@@ -0,0 +1,92 @@
+#ifndef REALTIME_FIELDS_H
+#define REALTIME_FIELDS_H
+
+#include <stdint.h>
+#include "ECUData.h"
+
+// Channels whose decoder is compiled out (ECUData::ChannelMask bits).
+// Contoh: -DECU_RT_FIELDS_DISABLED=0x40 membuang decoder BATTERY.
+#ifndef ECU_RT_FIELDS_DISABLED
+#define ECU_RT_FIELDS_DISABLED 0
+#endif
+
+/**
+ * @brief Deskriptor field realtime block Speeduino yang dievaluasi saat compile
+ *
+ * Setiap field didefinisikan satu kali (offset, lebar, signed, skala, channel
+ * tujuan, member ECUData tujuan). RealtimeLayout<...> mengubah daftar field
+ * menjadi decoder yang di-unroll (satu blok kode per field, tanpa tabel atau
+ * loop saat runtime) serta tabel offset/lebar untuk window request 'r'.
+ *
+ * Field yang dimatikan lewat ECU_RT_FIELDS_DISABLED tidak menghasilkan kode.
+ */
+namespace rt {
+
+template <typename M> struct MemberType;
+template <typename T> struct MemberType<T ECUData::*> { typedef T type; };
+
+// Offset/width of one channel inside the realtime block (width 0 = not decoded)
+struct FieldSpan { uint8_t offset; uint8_t width; };
+
+/**
+ * Source harus menyediakan: has(offset, width), byte(offset), word(offset) (LE16).
+ * Nilai tujuan = raw (signed/unsigned sesuai deskriptor) * Scale.
+ * Bit channel di ECUData::changedChannels() hanya diset bila nilainya berubah.
+ */
+template <uint8_t Offset, uint8_t Width, bool Signed, uint8_t Scale, ECUData::Channel Ch, auto Target>
+struct Field {
+    static_assert(Width == 1 || Width == 2, "realtime fields are 1 or 2 bytes wide");
+    typedef typename MemberType<decltype(Target)>::type value_type;
+
+    static constexpr uint8_t OFFSET = Offset;
+    static constexpr uint8_t WIDTH = Width;
+    static constexpr ECUData::Channel CHANNEL = Ch;
+    static constexpr bool ENABLED = !(ECU_RT_FIELDS_DISABLED & ECUData::channelBit(Ch));
+
+    template <typename Source>
+    static void decode(const Source &src, ECUData &ecu, ECUData::ChannelMask mask) {
+        if constexpr (ENABLED) {
+            if (!(mask & ECUData::channelBit(Ch)) || !src.has(Offset, Width)) return;
+            ecu.store(Ch, Target, read_(src));
+        }
+    }
+
+private:
+    template <typename Source>
+    static value_type read_(const Source &src) {
+        if constexpr (Width == 2) {
+            uint16_t w = src.word(Offset);
+            if constexpr (Signed) return (value_type)((int16_t)w * Scale);
+            else return (value_type)(w * Scale);
+        } else {
+            uint8_t b = src.byte(Offset);
+            if constexpr (Signed) return (value_type)((int8_t)b * Scale);
+            else return (value_type)((uint16_t)b * Scale);
+        }
+    }
+};
+
+template <typename... Fields>
+struct RealtimeLayout {
+    static constexpr uint8_t CHANNELS = (uint8_t)ECUData::Channel::COUNT;
+
+    // Unrolled: each field expands to its own inline decode
+    template <typename Source>
+    static void decode(const Source &src, ECUData &ecu, ECUData::ChannelMask mask) {
+        (Fields::decode(src, ecu, mask), ...);
+    }
+
+    // Span per channel (indexed by Channel), built at compile time
+    struct Spans {
+        FieldSpan v[CHANNELS];
+        constexpr Spans() : v() {
+            ((v[(uint8_t)Fields::CHANNEL] = FieldSpan{ Fields::ENABLED ? Fields::OFFSET : (uint8_t)0,
+                                                       Fields::ENABLED ? Fields::WIDTH : (uint8_t)0 }), ...);
+        }
+    };
+    static constexpr Spans SPANS = Spans();
+};
+
+}  // namespace rt
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef RX_RING_H
+#define RX_RING_H
+
+#include <stdint.h>
+
+/**
+ * @class RxRing
+ * @brief Ring buffer RX power-of-two, single-producer / single-consumer
+ *
+ * Producer (ISR) hanya menulis head_, consumer (loop) hanya menulis tail_.
+ * Index 8-bit sehingga baca/tulis index atomik di AVR tanpa cli().
+ * Kapasitas efektif = N - 1 byte (satu slot kosong membedakan penuh/kosong).
+ *
+ * Byte yang belum dikonsumsi dapat dibaca langsung (peek) sehingga decoder
+ * bisa bekerja in-place tanpa menyalin frame ke buffer terpisah.
+ */
+template <uint16_t N>
+class RxRing {
+    static_assert(N >= 16 && N <= 256, "RxRing size must be 16..256");
+    static_assert((N & (N - 1)) == 0, "RxRing size must be a power of two");
+
+public:
+    static constexpr uint8_t MASK = (uint8_t)(N - 1);
+    static constexpr uint8_t CAPACITY = (uint8_t)(N - 1);
+
+    // Producer side (ISR context). Returns false when the byte was dropped.
+    bool push(uint8_t b) {
+        uint8_t h = head_;
+        uint8_t next = (uint8_t)((h + 1) & MASK);
+        if (next == tail_) {
+            if (overflows_ != 0xFFFF) overflows_++;
+            return false;
+        }
+        buf_[h] = b;
+        barrier_();
+        head_ = next;
+        return true;
+    }
+
+    // Consumer side
+    uint8_t available() const {
+        uint8_t n = (uint8_t)((head_ - tail_) & MASK);
+        barrier_();
+        return n;
+    }
+
+    // i-th unread byte (0 = oldest); caller must ensure i < available()
+    uint8_t peek(uint8_t i) const { return buf_[(uint8_t)((tail_ + i) & MASK)]; }
+
+    // Little-endian 16-bit helper for in-place decoding
+    uint16_t peek16(uint8_t i) const {
+        return (uint16_t)peek(i) | ((uint16_t)peek((uint8_t)(i + 1)) << 8);
+    }
+
+    uint8_t pop() {
+        uint8_t t = tail_;
+        uint8_t b = buf_[t];
+        tail_ = (uint8_t)((t + 1) & MASK);
+        return b;
+    }
+
+    // Release n consumed bytes back to the producer
+    void skip(uint8_t n) {
+        uint8_t a = available();
+        if (n > a) n = a;
+        tail_ = (uint8_t)((tail_ + n) & MASK);
+    }
+
+    void clear() { tail_ = head_; }
+
+    // Byte received i positions ago (0 = newest), consumed or not.
+    // Used for debug dumps; old slots are overwritten as data arrives.
+    uint8_t recent(uint8_t i) const { return buf_[(uint8_t)((head_ - 1 - i) & MASK)]; }
+
+    // Free-running write index; consumers diff it to count fresh bytes
+    uint8_t head() const { return head_; }
+
+    uint16_t overflows() const { return overflows_; }
+
+private:
+    static inline void barrier_() { __asm__ __volatile__("" ::: "memory"); }
+
+    uint8_t buf_[N] = {0};
+    volatile uint8_t head_ = 0;
+    volatile uint8_t tail_ = 0;
+    volatile uint16_t overflows_ = 0;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SESSION_STATS_H
+#define SESSION_STATS_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "ECUData.h"
+
+/**
+ * @class SessionStats
+ * @brief Statistik sesi per channel inti (min/max/mean/variance), streaming
+ *
+ * Diupdate sekali per frame selama mesin hidup (rpm > 0). Tanpa pembagian
+ * per frame: setiap channel menjumlah d = x - K dan d^2 dengan K = sampel
+ * pertama (shifted data). Hasilnya setara Welford tetapi di AVR hanya
+ * perkalian 16x16 dan penjumlahan 32-bit plus carry ke word atas (jumlah
+ * 64-bit tanpa aritmetika 64-bit per sampel), bukan pembagian 32-bit.
+ * Mean dan variance dihitung saat dibaca.
+ */
+class SessionStats {
+public:
+    static constexpr uint8_t CHANNELS = (uint8_t)ECUData::Channel::BATTERY + 1;  // core
+
+    SessionStats() { reset(); }
+
+    void reset();
+
+    // Call once per decoded frame (not for a republished stale one)
+    void update(const ECUData &ecu_data);
+
+    uint32_t samples() const { return count_; }
+    // (not min/max: those are macros in the AVR Arduino core)
+    int16_t minimum(ECUData::Channel ch) const { return acc_[(uint8_t)ch].min; }
+    int16_t maximum(ECUData::Channel ch) const { return acc_[(uint8_t)ch].max; }
+    int32_t mean(ECUData::Channel ch) const;      // rounded, channel units
+    float variance(ECUData::Channel ch) const;    // sample variance, units^2
+
+    // Summary on Serial (or any Print)
+    void dump(Print &out) const;
+
+private:
+    struct Acc {
+        int16_t shift;     // K: first sample
+        int16_t min;
+        int16_t max;
+        // 64-bit sums as two 32-bit words: the hot path adds 32 bits and
+        // propagates the carry, int64 is only assembled when read
+        uint32_t sum_lo;   // sum(x - K), two's complement
+        int32_t sum_hi;
+        uint32_t sumsq_lo; // sum((x - K)^2)
+        uint32_t sumsq_hi;
+        int64_t sum() const { return (int64_t)(((uint64_t)(uint32_t)sum_hi << 32) | sum_lo); }
+        uint64_t sumsq() const { return ((uint64_t)sumsq_hi << 32) | sumsq_lo; }
+    };
+    Acc acc_[CHANNELS];
+    uint32_t count_;
+};
+
+#endif
@@ -4,6 +4,26 @@
 #include <Arduino.h>
 #include <stdint.h>
 #include "ECUData.h"
+#include "RealtimeFields.h"
+#include "FixedPoint.h"
+#include "RxRing.h"
+#include "LinkQuality.h"
+
+// RX ring size (power of two). Filled from a timer ISR so bytes keep flowing
+// while the loop is blocked by a long TFT redraw. Must hold one 128-byte frame.
+#ifndef ECU_RX_RING_SIZE
+#define ECU_RX_RING_SIZE 256
+#endif
+
+// ASCII line buffer (CSV / key=value). A 7-column CSV line needs ~40 chars;
+// the Uno build trims it to save SRAM.
+#ifndef ECU_LINE_BUFFER_SIZE
+#if defined(__AVR_ATmega328P__)
+#define ECU_LINE_BUFFER_SIZE 96
+#else
+#define ECU_LINE_BUFFER_SIZE 160
+#endif
+#endif
 
 /**
  * @class SpeeduinoParser
@@ -15,6 +35,10 @@
  * - Total frame: ~128 byte
  * 
  * Parser adalah passive listener (read-only), tidak mengirim data ke ECU.
+ *
+ * RX path: UART hardware -> RxRing (diisi dari ISR Timer0 COMPA ~1 kHz di AVR)
+ * -> decoder membaca frame langsung dari ring (in-place, tanpa salinan).
+ * Definisikan ECU_RX_NO_ISR untuk kembali ke polling dari update().
  */
 class SpeeduinoParser {
 public:
@@ -22,6 +46,12 @@ public:
     static constexpr uint8_t FRAME_HEADER = 0xAA;
     static constexpr uint16_t FRAME_SIZE = 128;
     static constexpr uint8_t MAX_CONSECUTIVE_ERRORS = 10;
+    static constexpr uint8_t DETECT_LOCK_FRAMES = 3;   // same protocol N times -> lock
+
+    // Baud autodetect (disable with -DECU_BAUD_FIXED)
+    static constexpr uint16_t BAUD_RESCAN_MS = 3000;    // no valid frame this long -> scan
+    static constexpr uint16_t BAUD_DWELL_MS = 600;      // listening time per candidate
+    static constexpr uint8_t BAUD_EARLY_LOCK = 3;       // valid frames that end the scan
     
     // Data offsets untuk Speeduino primary realtime response (74 bytes, no header)
     // Based on Speeduino 3.5+ format per TurboMarian example
@@ -36,19 +66,112 @@ public:
     static constexpr uint8_t OFFSET_ADV = 23;          // 1 byte (advance/ignition)
     static constexpr uint8_t OFFSET_TPS = 24;          // 1 byte (TPS %)
     static constexpr uint8_t OFFSET_FLEX = 34;         // 1 byte (flex fuel %)
+    static constexpr uint8_t OFFSET_EGO = 11;          // 1 byte (O2 correction %)
+    static constexpr uint8_t OFFSET_TAE = 16;          // 1 byte (accel enrichment %)
+    static constexpr uint8_t OFFSET_CORRECTIONS = 17;  // 1 byte (total fuel correction %)
+    static constexpr uint8_t OFFSET_VE = 18;           // 1 byte (VE %)
+    static constexpr uint8_t OFFSET_AFR_TARGET = 19;   // 1 byte (AFR/10)
+    static constexpr uint8_t OFFSET_PW1 = 20;          // bytes 20-21, little-endian (us)
+    static constexpr uint8_t OFFSET_TPS_DOT = 22;      // 1 byte (%/s / 10)
+    static constexpr uint8_t OFFSET_BOOST_TARGET = 29; // 1 byte (kPa / 2)
+    static constexpr uint8_t OFFSET_BOOST_DUTY = 30;   // 1 byte (%)
+    static constexpr uint8_t OFFSET_RPM_DOT = 32;      // bytes 32-33, little-endian signed (rpm/s)
+    static constexpr uint8_t OFFSET_AFR2 = 39;         // 1 byte (second O2, AFR/10)
+    static constexpr uint8_t OFFSET_BARO = 40;         // 1 byte (kPa)
+    // Beyond the 74-byte block: only reachable through 'r' on firmware that
+    // serves the longer log entry (202x); older ECUs never answer these
+    static constexpr uint8_t OFFSET_VSS = 100;         // bytes 100-101, little-endian (km/h)
+    static constexpr uint8_t OFFSET_GEAR = 102;        // 1 byte
     static constexpr uint16_t PRIMARY_RESPONSE_SIZE = 74;  // Primary realtime response size
+
+    // Legacy 0xAA stream frame (128 bytes), offsets from the header byte
+    static constexpr uint8_t LEGACY_OFFSET_RPM = 1;      // bytes 1-2, little-endian
+    static constexpr uint8_t LEGACY_OFFSET_CLT = 3;      // 1 byte (signed, °C)
+    static constexpr uint8_t LEGACY_OFFSET_AFR = 5;      // bytes 5-6, little-endian (100x)
+    static constexpr uint8_t LEGACY_OFFSET_MAP = 7;      // 1 byte (kPa)
+    static constexpr uint8_t LEGACY_OFFSET_TPS = 11;     // 1 byte (%)
+    static constexpr uint8_t LEGACY_OFFSET_IAT = 15;     // 1 byte (signed, °C)
+    static constexpr uint8_t LEGACY_OFFSET_BATTERY = 21; // 1 byte (0.1V per unit)
+    static constexpr uint8_t LEGACY_OFFSET_STATUS = 32;  // 1 byte, bit 0 = sync
+
+    // 'r' output-channel read: 'r', canId, 0x30, offset (LE16), length (LE16)
+    static constexpr uint8_t SELECTIVE_READ_CMD = 'r';
+    static constexpr uint8_t SELECTIVE_READ_TABLE = 0x30;   // realtime data page
+
+    // New serial protocol envelope: 2-byte length + 4-byte CRC32 around the payload
+    static constexpr uint8_t FRAMED_OVERHEAD = 6;
+    static constexpr uint8_t SERIAL_RC_OK = 0x00;
     
+    // Wire protocol; DETECT feeds all decoders until one wins DETECT_LOCK_FRAMES times
+    enum class Protocol : uint8_t {
+        DETECT,
+        PRIMARY,        // 'A' request, 74-byte headerless response
+        FRAMED,         // new serial protocol: length + payload + CRC32
+        LEGACY_AA,      // 0xAA-headed 128-byte stream
+        GENERIC_CSV,    // Secondary Serial Generic Fixed
+        KEY_VALUE       // KEY=value ASCII lines
+    };
+
+    // Why a frame was rejected (counted per reason in the stats)
+    enum class RejectReason : uint8_t {
+        PLAUSIBILITY,   // decoded values out of range
+        PARSE,          // ASCII line not understood
+        TIMEOUT,        // request unanswered after retries
+        NO_HEADER,      // 0xAA stream lost
+        LENGTH,         // envelope length does not match the request
+        CRC,            // envelope CRC32 mismatch
+        RETURN_CODE,    // ECU answered with an error code
+        COUNT
+    };
+
+    // Generic Fixed CSV column map: Channel id per column (UNUSED = skip)
+    struct CsvSchema {
+        static constexpr uint8_t MAX_COLUMNS = 24;
+        static constexpr uint8_t UNUSED = 0xFF;
+        uint8_t columns[MAX_COLUMNS];
+    };
+
     SpeeduinoParser(uint32_t serial_baud = 115200);
     
     // Initialize serial communication
     void begin(HardwareSerial &serial = Serial);
     
     // Optional: enable primary request mode (active polling)
-    // Sends a single-byte command periodically to request realtime data
+    // Sends a single-byte command periodically to request realtime data.
+    // cmd 'r' switches to selective reads of the requested channels only.
+    // period_ms paces requests while detecting / after failures; once locked
+    // to PRIMARY, requests are pipelined back-to-back (min gap below).
     void configureRequest(uint8_t cmd, uint32_t period_ms);
+    void setMinRequestGap(uint16_t gap_ms) { request_min_gap_ms_ = gap_ms; }
+    // Wrap requests in the new protocol envelope and expect CRC-checked replies
+    void setFramedProtocol(bool enabled) { framed_requests_ = enabled; }
+    // CSV column order (TunerStudio Secondary Serial). persist = save to EEPROM.
+    // A header line ("RPM,MAP,...") on the link sets and saves it automatically.
+    void setCsvSchema(const CsvSchema &schema, bool persist = false);
+    const CsvSchema &getCsvSchema() const { return csv_schema_; }
+
+    static constexpr uint16_t PRIMARY_TIMEOUT_MS = 150;       // upper bound / before first measurement
+    static constexpr uint16_t RESPONSE_TIMEOUT_MIN_MS = 20;
+    static constexpr uint16_t RESPONSE_TIMEOUT_MARGIN_MS = 10;
+    static constexpr uint8_t MAX_REQUEST_RETRIES = 2;         // per request, before counting an error
+
+    // Channels the consumers need; in 'r' mode only their byte span is fetched
+    void setRequestedChannels(ECUData::ChannelMask channels);
+
+    // Multi-rate polling ('r' mode): each group is read at most every period_ms
+    // (0 = every request slot). Channels in no group are read every slot.
+    // Defaults: group 0 = RPM/MAP/TPS/AFR every slot, group 1 = CLT/IAT/BAT 500 ms.
+    static constexpr uint8_t MAX_POLL_GROUPS = 3;
+    void configurePollGroup(uint8_t group, ECUData::ChannelMask channels, uint16_t period_ms);
+    uint8_t getReadOffset() const { return read_offset_; }
+    uint8_t getReadLength() const { return read_length_; }
     
     // Non-blocking frame parsing dari serial buffer
     bool update(ECUData &ecu_data);
+
+    // Drain the hardware UART buffer into the RX ring.
+    // Called from the timer ISR; update() calls it directly when no ISR is installed.
+    void serviceRx();
     
     // Get parser statistics
     uint32_t getFramesReceived() const { return frames_received_; }
@@ -56,7 +179,18 @@ public:
     uint32_t getSyncLosses() const { return sync_losses_; }
     uint32_t getRawBytes() const { return raw_bytes_; }
     uint32_t getLastRxMillis() const { return last_rx_ms_; }
-    const char* getLastLine() const { return last_line_[0] ? last_line_ : ""; }
+    uint32_t getBaudRate() const { return baud_rate_; }
+    bool isBaudScanning() const { return baud_scanning_; }
+    uint32_t getTurnaroundMicros() const { return rtt_ewma_us_; }
+    uint16_t getRequestTimeouts() const { return request_timeouts_; }
+    uint16_t getRequestRetries() const { return request_retries_; }
+    uint16_t getRejectCount(RejectReason reason) const { return reject_counts_[(uint8_t)reason]; }
+    uint16_t getResyncs() const { return resyncs_; }
+    Protocol getProtocol() const { return protocol_; }
+    const char* getProtocolString() const;
+    uint16_t getRxOverflows() const { return rx_.overflows(); }
+    // Frame rate / jitter / error rate estimate (drives SyncManager)
+    const LinkQuality& getLinkQuality() const { return link_; }
     
     // Debug output
     void debugPrint() const;
@@ -64,6 +198,17 @@ public:
 private:
     HardwareSerial *serial_;
     uint32_t baud_rate_;
+    bool baud_auto_ = false;
+    bool baud_scanning_ = false;
+    uint8_t baud_index_ = 0;
+    uint8_t baud_best_index_ = 0;
+    int16_t baud_best_score_ = 0;
+    uint32_t baud_dwell_start_ = 0;
+    uint32_t baud_frames_mark_ = 0;   // counters at the start of the dwell
+    uint32_t baud_errors_mark_ = 0;
+    uint32_t last_valid_ms_ = 0;      // last decoded frame (drives rescans)
+    uint32_t baud_seen_frames_ = 0;
+    uint32_t data_frames_ = 0;        // frames that carried channel data
     
     // Parser state machine
     enum class ParserState {
@@ -74,24 +219,49 @@ private:
     };
     
     ParserState state_;
-    uint8_t frame_buffer_[FRAME_SIZE];
-    uint16_t buffer_index_;
     uint8_t consecutive_errors_;
 
+    // Protocol lock-in
+    Protocol protocol_ = Protocol::DETECT;
+    Protocol detect_candidate_ = Protocol::DETECT;
+    uint8_t detect_hits_ = 0;
+    uint8_t garbage_bytes_ = 0;  // bytes skipped while hunting a header (locked mode)
+
+    // Zero-copy RX: frames are decoded straight out of the ring
+    RxRing<ECU_RX_RING_SIZE> rx_;
+    static_assert(RxRing<ECU_RX_RING_SIZE>::CAPACITY >= FRAME_SIZE, "RX ring must hold a full frame");
+    bool rx_isr_ = false;       // ring filled from timer ISR
+    uint8_t rx_seen_ = 0;       // ring head at last update(), for byte accounting
+    uint8_t scan_pos_ = 0;      // unread bytes already examined by update()
+    uint8_t frame_off_ = 0;     // frame start, relative to ring tail
+    uint8_t frame_len_ = 0;     // PRIMARY_RESPONSE_SIZE or FRAME_SIZE once ready
+
     // Generic Fixed CSV line buffer (secondary serial)
-    static constexpr uint16_t LINE_BUFFER_SIZE = 160;
+    static constexpr uint16_t LINE_BUFFER_SIZE = ECU_LINE_BUFFER_SIZE;
     char line_buffer_[LINE_BUFFER_SIZE];
+    CsvSchema csv_schema_;
+    uint8_t csv_last_column_ = 0;   // decoder stops after this column
+    uint8_t csv_min_columns_ = 5;
     uint16_t line_index_;
     bool line_ready_;
-    char last_line_[LINE_BUFFER_SIZE];
     
     // Statistics
     uint32_t frames_received_;
     uint32_t frames_errored_;
     uint32_t sync_losses_;
-    uint8_t valid_streak_ = 0; // consecutive valid frames
+    LinkQuality link_;
     uint32_t raw_bytes_ = 0;    // raw bytes observed on serial
     uint32_t last_rx_ms_ = 0;   // last time a byte was seen
+    uint16_t reject_counts_[(uint8_t)RejectReason::COUNT] = {0};
+
+    // Headerless response resync: alignments tried past offset 0, and the
+    // last accepted raw core values for the rate-of-change score
+    static constexpr uint8_t RESYNC_MAX_SHIFT = 4;
+    static constexpr uint8_t RESYNC_CHANNELS = (uint8_t)ECUData::Channel::BATTERY + 1;
+    static constexpr int16_t RESYNC_REJECT = -32767;
+    int16_t resync_prev_[RESYNC_CHANNELS] = {0};
+    uint8_t resync_prev_valid_ = 0;
+    uint16_t resyncs_ = 0;
 
     // Primary request mode
     bool request_mode_ = false;
@@ -100,14 +270,114 @@ private:
     uint32_t last_request_ms_ = 0;
     bool expect_primary_ = false;      // after sending request, expect 74-byte primary
     uint32_t primary_expect_deadline_ = 0; // timeout for expecting primary response
+    uint32_t request_sent_us_ = 0;
+    uint32_t rtt_ewma_us_ = 0;         // smoothed request -> complete response time
+    uint16_t request_min_gap_ms_ = 0;
+    uint16_t request_timeouts_ = 0;
+    uint16_t request_retries_ = 0;
+    uint8_t retry_count_ = 0;          // retries of the current request
+    bool framed_requests_ = false;     // new protocol envelope on requests/responses
+    bool pipeline_ready_ = false;      // last response good: next request may go out now
+    mutable uint32_t util_last_ms_ = 0;     // debugPrint() utilisation window
+    mutable uint32_t util_last_bytes_ = 0;
+    uint8_t response_len_ = PRIMARY_RESPONSE_SIZE;  // bytes expected for the pending request
+    uint8_t response_base_ = 0;                     // realtime offset of its first byte
+    uint8_t read_offset_ = 0;                       // 'r' window into the realtime block
+    uint8_t read_length_ = PRIMARY_RESPONSE_SIZE;
+    ECUData::ChannelMask requested_channels_ = ECUData::CORE_CHANNELS;
+    ECUData::ChannelMask subscribed_ = 0;   // extended channels some consumer reads
+    ECUData::ChannelMask response_mask_ = ECUData::CORE_CHANNELS;  // channels decoded from the pending response
+    uint8_t response_groups_ = 0;                                  // poll groups it refreshes
+
+    struct PollGroup {
+        ECUData::ChannelMask channels;
+        uint16_t period_ms;
+        uint32_t last_ms;    // last successful read
+    };
+    PollGroup poll_groups_[MAX_POLL_GROUPS];
+    uint8_t frame_base_ = 0;     // realtime-block offset of the frame's first byte
+    ECUData::ChannelMask frame_mask_ = ECUData::CORE_CHANNELS;  // channels to decode from it
+
+    // Realtime block layout: offset, width, signed, scale, channel, target
+    typedef rt::RealtimeLayout<
+        rt::Field<OFFSET_MAP_LO, 2, false, 1, ECUData::Channel::MAP, &ECUData::map>,         // kPa
+        rt::Field<OFFSET_IAT, 1, true, 1, ECUData::Channel::IAT, &ECUData::iat>,             // °C
+        rt::Field<OFFSET_CLT, 1, true, 1, ECUData::Channel::CLT, &ECUData::clt>,             // °C
+        rt::Field<OFFSET_BATTERY, 1, false, 100, ECUData::Channel::BATTERY, &ECUData::battery>,  // 0.1V -> mV
+        rt::Field<OFFSET_AFR, 1, false, 10, ECUData::Channel::AFR, &ECUData::afr>,           // AFR*10 -> AFR*100
+        rt::Field<OFFSET_RPM_LO, 2, false, 1, ECUData::Channel::RPM, &ECUData::rpm>,
+        rt::Field<OFFSET_TPS, 1, false, 1, ECUData::Channel::TPS, &ECUData::tps>,            // %
+        rt::Field<OFFSET_ADV, 1, true, 1, ECUData::Channel::ADVANCE, &ECUData::advance>,
+        rt::Field<OFFSET_VE, 1, false, 1, ECUData::Channel::VE, &ECUData::ve>,
+        rt::Field<OFFSET_AFR_TARGET, 1, false, 1, ECUData::Channel::AFR_TARGET, &ECUData::afrTarget>,
+        rt::Field<OFFSET_PW1, 2, false, 1, ECUData::Channel::PW1, &ECUData::pw1>,
+        rt::Field<OFFSET_TAE, 1, false, 1, ECUData::Channel::TAE, &ECUData::tae>,
+        rt::Field<OFFSET_CORRECTIONS, 1, false, 1, ECUData::Channel::CORRECTIONS, &ECUData::corrections>,
+        rt::Field<OFFSET_EGO, 1, false, 1, ECUData::Channel::EGO, &ECUData::ego>,
+        rt::Field<OFFSET_BARO, 1, false, 1, ECUData::Channel::BARO, &ECUData::baro>,
+        rt::Field<OFFSET_BOOST_TARGET, 1, false, 2, ECUData::Channel::BOOST_TARGET, &ECUData::boostTarget>,
+        rt::Field<OFFSET_BOOST_DUTY, 1, false, 1, ECUData::Channel::BOOST_DUTY, &ECUData::boostDuty>,
+        rt::Field<OFFSET_FLEX, 1, false, 1, ECUData::Channel::FLEX, &ECUData::flex>,
+        rt::Field<OFFSET_RPM_DOT, 2, true, 1, ECUData::Channel::RPM_DOT, &ECUData::rpmDot>,
+        rt::Field<OFFSET_AFR2, 1, false, 1, ECUData::Channel::AFR2, &ECUData::afr2>,
+        rt::Field<OFFSET_TPS_DOT, 1, false, 10, ECUData::Channel::TPS_DOT, &ECUData::tpsDot>,
+        rt::Field<OFFSET_VSS, 2, false, 1, ECUData::Channel::VSS, &ECUData::vss>,
+        rt::Field<OFFSET_GEAR, 1, false, 1, ECUData::Channel::GEAR, &ECUData::gear>
+    > RealtimeLayout;
+
+    // Legacy 0xAA frame layout (core channels only)
+    typedef rt::RealtimeLayout<
+        rt::Field<LEGACY_OFFSET_RPM, 2, false, 1, ECUData::Channel::RPM, &ECUData::rpm>,
+        rt::Field<LEGACY_OFFSET_CLT, 1, true, 1, ECUData::Channel::CLT, &ECUData::clt>,
+        rt::Field<LEGACY_OFFSET_AFR, 2, false, 1, ECUData::Channel::AFR, &ECUData::afr>,
+        rt::Field<LEGACY_OFFSET_MAP, 1, false, 1, ECUData::Channel::MAP, &ECUData::map>,
+        rt::Field<LEGACY_OFFSET_TPS, 1, false, 1, ECUData::Channel::TPS, &ECUData::tps>,
+        rt::Field<LEGACY_OFFSET_IAT, 1, true, 1, ECUData::Channel::IAT, &ECUData::iat>,
+        rt::Field<LEGACY_OFFSET_BATTERY, 1, false, 100, ECUData::Channel::BATTERY, &ECUData::battery>
+    > LegacyLayout;
+
+    // Read access to the current frame for the layout decoder
+    struct FrameView {
+        const SpeeduinoParser &p;
+        bool has(uint8_t off, uint8_t width) const { return p.frameHas_(off, width); }
+        uint8_t byte(uint8_t off) const { return p.frameByte_(off); }
+        uint16_t word(uint8_t off) const { return p.frameWord_(off); }
+    };
 
-    // Debug: ring buffer of last received bytes
-    static constexpr uint8_t LAST_BYTES_CAP = 64;
-    uint8_t last_bytes_[LAST_BYTES_CAP];
-    uint8_t last_bytes_idx_ = 0;
-    
     // Private parsing methods
-    bool tryReadFrame_();
+    // Realtime-block offsets are translated by frame_base_ (non-zero for 'r' windows)
+    uint8_t frameByte_(uint8_t off) const { return rx_.peek((uint8_t)(frame_off_ + off - frame_base_)); }
+    uint16_t frameWord_(uint8_t off) const { return rx_.peek16((uint8_t)(frame_off_ + off - frame_base_)); }
+    bool frameHas_(uint8_t off, uint8_t width) const {
+        return off >= frame_base_ && off + width <= frame_base_ + frame_len_;
+    }
+    bool sendRequest_(uint32_t now);
+    void serviceRequests_(ECUData &ecu_data);
+    void issueRequest_(uint32_t now);
+    uint32_t responseTimeoutMs_() const;
+    void noteResponse_();
+    // Wrap-safe "now is at or past deadline" for millis() timestamps
+    static bool timeReached_(uint32_t now, uint32_t deadline) { return (int32_t)(now - deadline) >= 0; }
+    void computeWindow_(ECUData::ChannelMask channels, uint8_t &offset, uint8_t &length) const;
+    void releaseScanned_();
+    bool updateDetect_(ECUData &ecu_data);
+    bool updatePrimary_(ECUData &ecu_data);
+    bool updateFramed_(ECUData &ecu_data);
+    int8_t pollFramedResponse_(ECUData &ecu_data);
+    int8_t pollPrimaryResponse_(ECUData &ecu_data);
+    int16_t scoreAlignment_() const;
+    int16_t resyncRaw_(uint8_t ch, const rt::FieldSpan &f) const;
+    void writeRequest_(const uint8_t *payload, uint8_t len);
+    bool isRequestProtocol_() const { return protocol_ == Protocol::PRIMARY || protocol_ == Protocol::FRAMED; }
+    bool updateLegacy_(ECUData &ecu_data);
+    void dropLegacyByte_(ECUData &ecu_data);
+    bool updateLine_(ECUData &ecu_data);
+    bool collectLineByte_(uint8_t byte);
+    bool finishFrame_(ECUData &ecu_data, uint8_t consumed);
+    bool finishLine_(ECUData &ecu_data, Protocol kind);
+    void onFrameError_(ECUData &ecu_data, RejectReason reason);
+    void noteDetected_(Protocol kind);
+    void lockProtocol_(Protocol proto);
     bool validateFrame_() const;
     void extractDataFromFrame_(ECUData &ecu_data);
     void resetParserState_();
@@ -117,6 +387,17 @@ private:
     bool tryReadGenericFixedLine_();
     bool extractDataFromGenericFixed_(ECUData &ecu_data, const char *line);
     bool extractDataFromKeyValue_(ECUData &ecu_data, const char *line);
+    static uint16_t afr100FromDecimal_(const fixp::Decimal &d);
+    static uint16_t batteryMvFromDecimal_(const fixp::Decimal &d);
+    static void setExtendedChannel_(ECUData &ecu_data, ECUData::Channel ch, int32_t v);
+    void setDefaultCsvSchema_();
+    static constexpr uint8_t BAUD_NONE = 0xFF;
+    static uint8_t baudCandidateIndex_(uint32_t baud);
+    void serviceBaudScan_();
+    void switchBaud_(uint32_t baud);
+    void lockBaud_();
+    void applyCsvSchema_();
+    bool learnCsvHeader_(const char *line);
 };
 
 #endif
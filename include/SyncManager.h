@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include <stdint.h>
 #include "ECUData.h"
+#include "Trend.h"
+#include "Table2D.h"
+#include "LinkQuality.h"
 
 /**
  * @class SyncManager
@@ -13,9 +16,25 @@
  * recovery delay sebelum kembali ke normal.
  * 
  * Deteksi sync loss:
- * - Data timeout (no update > 500ms)
- * - Sync counter increment (ECU report)
- * - Threshold violation (CLT, AFR, battery)
+ * - Data timeout (no update > 500ms; dengan LinkQuality: 2 interval + 4 jitter)
+ * - Sync counter increment (ECU report) atau error rate link tinggi
+ * - Threshold violation (RPM, CLT, AFR, battery) lewat ALARM_TABLE
+ *
+ * Alarm: setiap baris tabel punya band caution, hysteresis, debounce dan
+ * opsi latch. Level baru hanya dipakai setelah bertahan debounce_ms; level
+ * turun hanya setelah nilai kembali melewati batas sejauh hysteresis. Alarm
+ * latch tetap WARNING sampai acknowledgeAlarms().
+ *
+ * Trend: CLT dan battery disampel tiap TREND_PERIOD_MS ke LinearTrend
+ * (least squares O(1) per sampel). Laju melewati batas -> CAUTION; batas
+ * statis diproyeksikan tercapai dalam time_to_limit_s -> WARNING, sebelum
+ * nilainya sendiri melewati batas. Laju di bawah noise kuantisasi (satu LSB
+ * step di dalam window) dianggap datar, dan verdict trend melewati debounce
+ * dan hysteresis yang sama dengan ALARM_TABLE.
+ *
+ * Batas AFR bisa berupa tabel 2D RPM x MAP (setAfrTables()): lookup bilinear
+ * fixed-point dengan bin axis yang di-cache antar frame. Tanpa tabel,
+ * afr_min/afr_max dipakai.
  */
 class SyncManager {
 public:
@@ -36,14 +55,91 @@ public:
         uint16_t battery_min;       // Min battery voltage [11000 mV = 11V]
         uint32_t data_timeout_ms;   // No data timeout [500ms]
         uint32_t recovery_delay_ms; // Recovery stabilization time [2000ms]
+        // Trend alarms (0 = off)
+        int16_t clt_rise_max = 20;       // CAUTION above dCLT/dt [C/min]; warm-up ~5-15
+        int16_t battery_fall_max = 1200; // CAUTION when falling faster [mV/min]
+        uint16_t time_to_limit_s = 60;   // WARNING if a limit is projected closer [s]
+        // Link quality (with attachLink())
+        uint8_t link_loss_error_pct = 30; // SYNC_LOSS at this EWMA error rate [%]
     };
     
+    enum class AlarmLevel : uint8_t { NONE, CAUTION, WARNING };
+
+    // One alarm rule; limits come from Thresholds, the rest is fixed here
+    struct AlarmRule {
+        ECUData::Channel channel;
+        uint8_t flags;          // ALARM_LOW / ALARM_HIGH / ALARM_LATCH
+        int16_t caution_band;   // caution zone inside the limit [channel units];
+                                // two-sided: at most 1/4 of the lo..hi window
+        int16_t hysteresis;     // distance back inside before a level clears
+        uint16_t debounce_ms;   // a new level must persist this long
+    };
+    static constexpr uint8_t ALARM_LOW = 0x01;    // limit below (x < min)
+    static constexpr uint8_t ALARM_HIGH = 0x02;   // limit above (x > max)
+    static constexpr uint8_t ALARM_LATCH = 0x04;  // WARNING held until acknowledged
+
+    //  channel                      flags                                 band  hyst  debounce
+    static constexpr AlarmRule ALARM_TABLE[] = {
+        { ECUData::Channel::RPM,     ALARM_HIGH,                              500,  200,   300 },
+        { ECUData::Channel::CLT,     ALARM_LOW | ALARM_HIGH | ALARM_LATCH,      5,    2,  2000 },
+        { ECUData::Channel::AFR,     ALARM_LOW | ALARM_HIGH,                  100,   30,   500 },
+        { ECUData::Channel::BATTERY, ALARM_LOW,                               500,  200,  1000 },
+    };
+    static constexpr uint8_t ALARM_COUNT = sizeof(ALARM_TABLE) / sizeof(ALARM_TABLE[0]);
+
+    // Trend window 16 s; the Uno keeps half the samples at twice the period
+#if defined(__AVR_ATmega328P__)
+    static constexpr uint8_t TREND_SAMPLES = 8;
+    static constexpr uint16_t TREND_PERIOD_MS = 2000;
+#else
+    static constexpr uint8_t TREND_SAMPLES = 16;
+    static constexpr uint16_t TREND_PERIOD_MS = 1000;
+#endif
+    // One LSB step inside the window reads as up to ~0.56 LSB/s; rates at or
+    // below these are quantisation noise, treated as flat (no projection)
+    static constexpr int16_t CLT_TREND_NOISE = 6;        // 1 C step [C/min]
+    static constexpr int16_t BATTERY_TREND_NOISE = 600;  // 0.1 V step [mV/min]
+    // Trend verdict must hold for three samples; a level clears only once
+    // the rate drops below 3/4 of its limit / the projection beyond 5/4
+    static constexpr uint16_t TREND_DEBOUNCE_MS = 3 * TREND_PERIOD_MS;
+
+    // AFR limit table: X = RPM, Y = MAP [kPa], values AFR x100
+    typedef Table2D<8, 8> AfrTable;
+
     SyncManager();
     
     // Set custom thresholds
     void setThresholds(const Thresholds &thresholds);
     // Get thresholds (read-only)
     const Thresholds& getThresholds() const { return thresholds_; }
+    // Link estimate from the parser; nullptr = fixed timeout / counter only
+    void attachLink(const LinkQuality *link) { link_ = link; }
+
+    // RPM/MAP-indexed AFR limits (caller owns the tables); nullptr = scalar
+    void setAfrTables(const AfrTable *afr_min, const AfrTable *afr_max);
+
+    // Channels evaluated by the alarm table
+    static constexpr ECUData::ChannelMask monitoredChannels() {
+        ECUData::ChannelMask mask = 0;
+        for (const AlarmRule &rule : ALARM_TABLE) mask |= ECUData::channelBit(rule.channel);
+        // Axes of the AFR tables
+        return mask | ECUData::channelBit(ECUData::Channel::RPM) | ECUData::channelBit(ECUData::Channel::MAP);
+    }
+
+    // Committed (debounced) level of rule i in ALARM_TABLE
+    AlarmLevel getAlarmLevel(uint8_t i) const { return (AlarmLevel)alarms_[i].level; }
+    // Same for the rule watching ch (NONE if it has none); the AFR level
+    // already reflects the RPM/MAP table limits
+    AlarmLevel getAlarmLevel(ECUData::Channel ch) const;
+    // Channels currently at CAUTION or WARNING
+    ECUData::ChannelMask activeAlarms() const;
+    // Release latched alarms whose committed level has left WARNING (value
+    // back inside the limits); the others stay latched
+    void acknowledgeAlarms();
+
+    // Trend of CLT / BATTERY (window full, else 0 / -1)
+    int32_t getTrendPerMin(ECUData::Channel ch) const;   // units per minute
+    int32_t getTimeToLimit(ECUData::Channel ch) const;   // seconds, -1 = none
     
     // Get current state
     SyncState getState() const { return current_state_; }
@@ -76,11 +172,48 @@ private:
     uint16_t previous_sync_counter_;
     
     Thresholds thresholds_;
+    bool thresholds_changed_;      // Force one evaluation after setThresholds()
+    const LinkQuality *link_;
+    const AfrTable *afr_min_table_;
+    const AfrTable *afr_max_table_;
+    uint16_t rpm_;                 // operating point for the AFR tables
+    uint16_t map_;
+
+    struct AlarmState {
+        uint8_t level;             // committed AlarmLevel
+        uint8_t pending;           // raw level waiting for debounce
+        bool latched;
+        uint32_t pending_since;
+    };
+    AlarmState alarms_[ALARM_COUNT];
+    bool alarms_pending_;          // a debounce timer is running
+
+    struct TrendAlarm {
+        LinearTrend<TREND_SAMPLES, TREND_PERIOD_MS> fit;
+        int32_t rate;              // units per minute, cached per sample
+        int32_t ttl_s;             // time to limit, -1 = none
+        uint8_t raw;               // AlarmLevel of the last sample
+        AlarmState alarm;          // debounced like ALARM_TABLE rows
+    };
+    TrendAlarm clt_trend_;
+    TrendAlarm battery_trend_;
+    uint32_t trend_sample_ms_;
     
     // Private state machine logic
     void evaluateThresholds_(const ECUData &ecu_data);
+    AlarmLevel classify_(const AlarmRule &rule, int32_t value, AlarmLevel current) const;
+    AlarmLevel classifyTrend_(TrendAlarm &t, int32_t rise, int16_t noise, int16_t rise_max,
+                              int32_t limit) const;
+    AlarmLevel debounce_(AlarmState &a, AlarmLevel raw, uint16_t debounce_ms, bool latch,
+                         uint32_t now);
+    void limits_(ECUData::Channel ch, int32_t &lo, int32_t &hi) const;
+    bool sampleTrends_(const ECUData &ecu_data);
+    void clearTrends_();
     void handleStateTransition_(SyncState new_state);
     bool hasValidData_(const ECUData &ecu_data) const;
+    uint32_t dataTimeout_() const;
+    uint32_t recoveryDelay_() const;
+    bool linkFlaky_() const;
 };
 
 #endif
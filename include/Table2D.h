@@ -0,0 +1,86 @@
+#ifndef TABLE_2D_H
+#define TABLE_2D_H
+
+#include <stdint.h>
+
+/**
+ * @class Table2D
+ * @brief Tabel 2D gaya Speeduino (X = RPM, Y = MAP) dengan interpolasi bilinear
+ *
+ * Axis naik monoton. lookup() mencari bin X/Y mulai dari bin terakhir (titik
+ * kerja mesin bergerak pelan, jadi biasanya 0-1 langkah) dan menyimpan
+ * fraksi Q8; bila input sama dengan sebelumnya, pencarian dan pembagian
+ * dilewati. Interpolasi integer murni (Q8 x Q8), di luar axis di-clamp ke
+ * tepi tabel. Header-only, tanpa Arduino.
+ *
+ * Konstruktor constexpr: tabel global yang diisi dari array constexpr
+ * diinisialisasi konstan (image .data), jadi array sumbernya tidak ikut
+ * tersimpan di SRAM sebagai salinan kedua.
+ */
+template <uint8_t Cols, uint8_t Rows>
+class Table2D {
+    static_assert(Cols >= 2 && Rows >= 2, "Table2D needs at least 2x2 cells");
+
+public:
+    constexpr Table2D() : x_{}, y_{}, v_{} {}
+
+    constexpr Table2D(const uint16_t (&x)[Cols], const uint16_t (&y)[Rows],
+                      const int16_t (&v)[Rows][Cols])
+        : x_{}, y_{}, v_{} {
+        for (uint8_t c = 0; c < Cols; ++c) x_[c] = x[c];
+        for (uint8_t r = 0; r < Rows; ++r) {
+            y_[r] = y[r];
+            for (uint8_t c = 0; c < Cols; ++c) v_[r][c] = v[r][c];
+        }
+    }
+
+    // Tuning: a changed cell or axis invalidates the cached bins
+    void set(uint8_t row, uint8_t col, int16_t value) { v_[row][col] = value; }
+    void setAxisX(uint8_t i, uint16_t x) { x_[i] = x; xc_.valid = false; }
+    void setAxisY(uint8_t i, uint16_t y) { y_[i] = y; yc_.valid = false; }
+    int16_t cell(uint8_t row, uint8_t col) const { return v_[row][col]; }
+
+    int16_t lookup(uint16_t x, uint16_t y) const {
+        locate_(x_, Cols, x, xc_);
+        locate_(y_, Rows, y, yc_);
+        const int16_t *lo = v_[yc_.bin];
+        const int16_t *hi = v_[yc_.bin + 1];
+        int32_t fx = xc_.frac, fy = yc_.frac;
+        // Q8 along X, then Q8 along Y: |v| * 2^16 still fits int32
+        int32_t a = (int32_t)lo[xc_.bin] * (256 - fx) + (int32_t)lo[xc_.bin + 1] * fx;
+        int32_t b = (int32_t)hi[xc_.bin] * (256 - fx) + (int32_t)hi[xc_.bin + 1] * fx;
+        int32_t r = a * (256 - fy) + b * fy;
+        return (int16_t)((r + (r >= 0 ? 32768 : -32768)) / 65536);
+    }
+
+private:
+    struct AxisCache {
+        uint16_t input;   // last looked-up value
+        uint8_t bin;      // lower index, 0..N-2
+        uint16_t frac;    // position inside the bin, Q8 (0..256)
+        bool valid;
+    };
+
+    uint16_t x_[Cols];
+    uint16_t y_[Rows];
+    int16_t v_[Rows][Cols];
+    mutable AxisCache xc_ = { 0, 0, 0, false };
+    mutable AxisCache yc_ = { 0, 0, 0, false };
+
+    static void locate_(const uint16_t *axis, uint8_t n, uint16_t in, AxisCache &c) {
+        if (c.valid && c.input == in) return;
+        c.input = in;
+        c.valid = true;
+        if (in <= axis[0]) { c.bin = 0; c.frac = 0; return; }
+        if (in >= axis[n - 1]) { c.bin = n - 2; c.frac = 256; return; }
+        // Walk from the cached bin; inside the clamps axis[bin] <= in < axis[bin + 1]
+        uint8_t i = c.bin;
+        while (i > 0 && in < axis[i]) --i;
+        while (i < n - 2 && in >= axis[i + 1]) ++i;
+        c.bin = i;
+        uint16_t span = axis[i + 1] - axis[i];
+        c.frac = span ? (uint16_t)(((uint32_t)(in - axis[i]) << 8) / span) : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef TREND_H
+#define TREND_H
+
+#include <stdint.h>
+
+/**
+ * @class LinearTrend
+ * @brief Regresi linier integer (least squares) atas N sampel terakhir, O(1)
+ *
+ * Sampel diambil tiap PeriodMs dengan x = 0..N-1 (tertua..terbaru). Jumlah
+ * Sy dan Sxy diperbarui saat window bergeser tanpa loop: sampel tertua
+ * keluar, semua x turun satu (Sxy -= Sy - y0), sampel baru masuk di x = N-1.
+ * Sx dan Sxx konstan untuk window penuh, jadi slope = (N*Sxy - Sx*Sy) / D
+ * dengan D = N^2 (N^2 - 1) / 12. Pembagian hanya saat dibaca. Header-only,
+ * tanpa Arduino.
+ */
+template <uint8_t N, uint16_t PeriodMs>
+class LinearTrend {
+    static_assert(N >= 3 && N <= 64, "LinearTrend window must be 3..64 samples");
+
+public:
+    void clear() { count_ = head_ = 0; sy_ = sxy_ = 0; }
+
+    void push(int16_t y) {
+        if (count_ < N) {
+            sy_ += y;
+            sxy_ += (int32_t)count_ * y;
+            buf_[count_++] = y;
+            return;
+        }
+        int16_t y0 = buf_[head_];
+        sxy_ += (int32_t)(N - 1) * y - (sy_ - y0);
+        sy_ += (int32_t)y - y0;
+        buf_[head_] = y;
+        if (++head_ == N) head_ = 0;
+    }
+
+    bool full() const { return count_ == N; }
+
+    // Slope in channel units per minute (window must be full)
+    int32_t perMinute() const {
+        return (int32_t)((int64_t)num_() * 60000 / ((int64_t)DEN * PeriodMs));
+    }
+
+    // Seconds until the fitted line reaches limit; -1 if flat, moving away
+    // or already past it (window must be full)
+    int32_t secondsTo(int32_t limit) const {
+        int64_t num = num_();
+        // 2N*D * (limit - fitted newest), fitted newest = Sy/N + slope*(N-1)/2
+        int64_t gap = (int64_t)2 * N * DEN * limit -
+                      ((int64_t)2 * sy_ * DEN + num * N * (N - 1));
+        if (num == 0 || (gap < 0) != (num < 0)) return -1;
+        return (int32_t)(gap * PeriodMs / ((int64_t)2 * N * num * 1000));
+    }
+
+private:
+    static constexpr int32_t SX = (int32_t)N * (N - 1) / 2;
+    static constexpr int32_t DEN = (int32_t)N * N * ((int32_t)N * N - 1) / 12;
+
+    int16_t buf_[N];
+    uint8_t count_ = 0;
+    uint8_t head_ = 0;   // oldest sample once full
+    int32_t sy_ = 0;
+    int32_t sxy_ = 0;
+
+    int32_t num_() const { return (int32_t)N * sxy_ - SX * sy_; }
+};
+
+#endif
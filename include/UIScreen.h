@@ -7,12 +7,14 @@
 #include "ECUData.h"
 #include "SyncManager.h"
 #include "UIStateMachine.h"
+#include "SessionStats.h"
+#include "DerivedChannels.h"
 
 /**
  * @class UIScreen
- * @brief Renderer untuk UI slices (aircraft cockpit EFIS style)
+ * @brief Renderer untuk UI widgets (aircraft cockpit EFIS style)
  * 
- * Mengelola drawing untuk setiap UI slice:
+ * Mengelola drawing untuk setiap widget (lihat UIStateMachine::Widget):
  * - Header: Status, sync indicator, engine status
  * - RPM Field: Primary display (dominan)
  * - Engine Core: CLT, AFR, MAP, Battery (4-quadrant)
@@ -33,20 +35,37 @@
  * ├─────────────────────────────────────────┤
  * │ FOOTER (y=220..240, 20px)               │
  * └─────────────────────────────────────────┘
+ *
+ * render() hanya menyentuh widget yang dirty atau yang nilai tampilnya
+ * berubah (teks atau warna), lalu melaporkan widget yang sudah up to date.
+ * Pergantian halaman (grid, peak recall, layar penuh) menggambar ulang semua.
  */
 class UIScreen {
 public:
     UIScreen(DisplayManager &display);
     
-    // Full screen update
-    void render(const ECUData &ecu_data,
-                const SyncManager &sync_mgr,
-                const UIStateMachine &ui_state);
+    // Channels shown by the current layout (six cells + header battery)
+    ECUData::ChannelMask requiredChannels() const;
+
+    // Peak recall page (session min/max/mean) in place of the live grid;
+    // nullptr returns to live data (the page switch repaints the grid)
+    void showPeakRecall(const SessionStats *stats);
+    bool isPeakRecall() const { return peak_stats_ != nullptr; }
+
+    // Source for the footer FUEL readout (litres used); nullptr = "--.-"
+    void attachDerived(DerivedChannels *derived) { derived_ = derived; }
+
+    // Draw the dirty widgets. Returns the widgets now up to date (drawn, or
+    // re-checked and unchanged) for UIStateMachine::markDrawn(); widgets
+    // hidden behind a full page are not reported and stay dirty.
+    UIStateMachine::WidgetMask render(const ECUData &ecu_data,
+                                      const SyncManager &sync_mgr,
+                                      const UIStateMachine &ui_state);
     
-    // Individual slice rendering
+    // Individual widget rendering
     void renderHeader_(const ECUData &ecu_data, 
                       const SyncManager &sync_mgr,
-                      const UIStateMachine &ui_state);
+                      UIStateMachine::WidgetMask widgets);
     
     void renderRPMField_(const ECUData &ecu_data,
                        const SyncManager &sync_mgr);
@@ -67,6 +86,19 @@ public:
 private:
     DisplayManager &display_;
 
+    // Page shown by the last render(); a switch repaints everything
+    enum class Page : uint8_t {
+        NONE,
+        BOOT,
+        WAIT_ECU,
+        SYNCING,
+        SYNC_LOSS,
+        RECOVERY,
+        PEAK_RECALL,
+        GRID
+    };
+    Page page_ = Page::NONE;
+
     // Smoothed display values to make transitions more seamless
     struct Smooth {
         bool initialized = false;
@@ -79,11 +111,30 @@ private:
         float battery = 0; // in mV
     } smooth_;
 
-    // Previous value strings per cell to skip unnecessary redraws
-    // Order: [RPM, MAP, CLT, IAT, AFR, TPS]
-    char prevVals_[6][16] = {{0}};
+    DerivedChannels *derived_ = nullptr;
+    char prevFuel_[20] = {0};
+    char prevBat_[8] = {0};
+    const SessionStats *peak_stats_ = nullptr;
 
-    void updateSmooth_(const ECUData &ecu);
+    // Previous value strings and colours per cell to skip unnecessary redraws
+    // Order: [RPM, MAP, CLT, IAT, AFR, TPS]. Longest value is "-40C!!".
+    char prevVals_[6][8] = {{0}};
+    DisplayManager::Color prevColors_[6] = {};
+    static constexpr ECUData::Channel CELL_CHANNELS[6] = {
+        ECUData::Channel::RPM, ECUData::Channel::MAP, ECUData::Channel::CLT,
+        ECUData::Channel::IAT, ECUData::Channel::AFR, ECUData::Channel::TPS
+    };
+
+    // Channels whose smoothed value has not reached the raw value yet
+    ECUData::ChannelMask settling_ = 0;
+    // Cells to format this render (smoothed value moved or widget dirty)
+    ECUData::ChannelMask redraw_ = 0;
+    // AFR alarm level behind the cell's !/!! marker; reformat when it moves
+    SyncManager::AlarmLevel afrLevel_ = SyncManager::AlarmLevel::NONE;
+    static constexpr float SETTLE_EPS = 0.05f;
+
+    ECUData::ChannelMask updateSmooth_(const ECUData &ecu);
+    void approach_(ECUData::Channel ch, float &value, float target, float alpha);
     static float lerp_(float from, float to, float alpha);
     
     // Layout constants (pixel coordinates) — 3x2 grid sama rata (six-pack avionics)
@@ -102,6 +153,14 @@ private:
     
     // 3 kolom sama lebar
     static constexpr uint16_t CELL_W = 320 / 3;  // ~106px per cell
+
+    // Footer: state text on the left, FUEL readout from here to the edge
+    static constexpr uint16_t FUEL_X = 220;
+
+    static constexpr UIStateMachine::WidgetMask HEADER_WIDGETS =
+        UIStateMachine::widgetBit(UIStateMachine::Widget::HEADER_ECU) |
+        UIStateMachine::widgetBit(UIStateMachine::Widget::HEADER_SYNC) |
+        UIStateMachine::widgetBit(UIStateMachine::Widget::HEADER_BAT);
     
     // Helper methods
     DisplayManager::Color getStateColor_(SyncManager::SyncState state) const;
@@ -122,6 +181,9 @@ private:
                             const char* value,
                             DisplayManager::Color valueColor,
                             uint8_t valueSize);
+    Page pageFor_(const ECUData &ecu_data, const SyncManager &sync_mgr) const;
+    // Stores text and colour; true if either differs from the last draw
+    bool cellChanged_(uint8_t cell, const char *value, DisplayManager::Color color);
     const char* headerEcuStatusText_(const ECUData &ecu_data, const SyncManager &sync_mgr) const;
 
     // State-driven color helpers
@@ -133,6 +195,8 @@ private:
     void renderWaitECU_();
     void renderSyncing_();
     void renderRecovery_();
+    void renderPeakRecall_();
+    void renderFuel_(bool force);
 
     // Annotation helpers
     void annotateClt_(char *buf, size_t bufSize, int16_t clt, const SyncManager &sync_mgr) const;
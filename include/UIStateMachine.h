@@ -3,87 +3,128 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "ECUData.h"
 #include "SyncManager.h"
 
 /**
  * @class UIStateMachine
  * @brief Mengelola UI state dan rendering logic
- * 
+ *
  * State machine untuk koordinasi rendering:
  * - Mendeteksi state change (dari SyncManager)
- * - Set dirty-flag untuk slice yang perlu redraw
+ * - Set dirty bit hanya untuk widget yang terpengaruh
  * - Manage blink state untuk SYNC_LOSS mode
- * 
- * Slice categories:
- * - HEADER: Status mesin & sync info
- * - RPM_FIELD: Primary RPM display
- * - ENGINE_CORE: CLT, AFR, MAP, Battery
- * - CONTROL_DATA: TPS, IAT
- * - FOOTER: System message
- * - FULL_SCREEN: SYNC_LOSS override
+ *
+ * Dirty tracking per widget (1 bit dalam mask 32-bit). Setiap widget punya
+ * generation counter yang naik saat sumbernya berubah (channel data, flag
+ * link, sync state, blink) dan generation terakhir yang digambar; widget
+ * dirty selama keduanya berbeda (gen_ != drawn_gen_). Renderer melaporkan
+ * widget yang sudah up to date (markDrawn()), jadi widget yang tersembunyi
+ * di balik halaman penuh tetap dirty.
  */
 class UIStateMachine {
 public:
-    enum class UISlice {
-        HEADER,
-        RPM_FIELD,
-        ENGINE_CORE,
-        CONTROL_DATA,
-        FOOTER,
-        FULL_SCREEN  // SYNC_LOSS override
+    enum class Widget : uint8_t {
+        HEADER_ECU,     // ECU status text
+        HEADER_SYNC,    // sync loss counter
+        HEADER_BAT,     // battery voltage
+        CELL_RPM,
+        CELL_MAP,
+        CELL_CLT,
+        CELL_IAT,
+        CELL_AFR,
+        CELL_TPS,
+        FOOTER_STATE,   // state name
+        FOOTER_FUEL,    // litres used
+        FULL_SCREEN,    // full-page views (SYNC_LOSS, RECOVERY, BOOT, ...)
+        COUNT
     };
-    
+    typedef uint32_t WidgetMask;
+    static_assert((uint8_t)Widget::COUNT <= 32, "WidgetMask holds 32 widgets");
+
+    static constexpr WidgetMask widgetBit(Widget w) { return (WidgetMask)1 << (uint8_t)w; }
+    static constexpr WidgetMask ALL_WIDGETS = ((WidgetMask)1 << (uint8_t)Widget::COUNT) - 1;
+    // Cells are contiguous: CELL_RPM..CELL_TPS
+    static constexpr WidgetMask CELL_WIDGETS =
+        (((WidgetMask)1 << ((uint8_t)Widget::CELL_TPS + 1)) - 1) &
+        ~(((WidgetMask)1 << (uint8_t)Widget::CELL_RPM) - 1);
+    // Widgets whose colour or text follows the sync state
+    static constexpr WidgetMask STATE_WIDGETS =
+        CELL_WIDGETS | ((WidgetMask)1 << (uint8_t)Widget::HEADER_ECU) |
+        ((WidgetMask)1 << (uint8_t)Widget::FOOTER_STATE) |
+        ((WidgetMask)1 << (uint8_t)Widget::FULL_SCREEN);
+
+    // Widget showing a channel (0 = not shown)
+    static constexpr WidgetMask widgetsFor(ECUData::Channel ch) {
+        return ch == ECUData::Channel::RPM     ? widgetBit(Widget::CELL_RPM)
+             : ch == ECUData::Channel::MAP     ? widgetBit(Widget::CELL_MAP)
+             : ch == ECUData::Channel::CLT     ? widgetBit(Widget::CELL_CLT)
+             : ch == ECUData::Channel::IAT     ? widgetBit(Widget::CELL_IAT)
+             : ch == ECUData::Channel::AFR     ? widgetBit(Widget::CELL_AFR)
+             : ch == ECUData::Channel::TPS     ? widgetBit(Widget::CELL_TPS)
+             : ch == ECUData::Channel::BATTERY ? widgetBit(Widget::HEADER_BAT)
+             : 0;
+    }
+
     enum class BlinkState {
         OFF,
         ON,
         BLINKING
     };
-    
+
     UIStateMachine();
-    
+
     // Update state machine dengan sync state baru
     void update(SyncManager::SyncState sync_state);
-    
-    // Check jika slice perlu redraw
-    bool isSliceDirty(UISlice slice) const;
-    
-    // Clear dirty flag untuk slice (setelah redraw)
-    void markSliceClean(UISlice slice);
-    
+
+    // Data source: changed channels and link flags of the consumer snapshot
+    void noteData(const ECUData &ecu_data);
+
+    // Dirty widgets: generation not drawn yet
+    WidgetMask dirtyWidgets() const;
+    bool isDirty(Widget w) const { return gen_[(uint8_t)w] != drawn_gen_[(uint8_t)w]; }
+    uint8_t generation(Widget w) const { return gen_[(uint8_t)w]; }
+    uint8_t drawnGeneration(Widget w) const { return drawn_gen_[(uint8_t)w]; }
+
+    // Bump the generation of these widgets
+    void invalidate(WidgetMask widgets);
+    // Renderer brought these widgets up to their current generation
+    void markDrawn(WidgetMask widgets);
+
+    // Force every widget to redraw
+    void requestFullRedraw() { invalidate(ALL_WIDGETS); }
+
     // Get blink state untuk SYNC_LOSS visual effect
     BlinkState getBlinkState() const { return blink_state_; }
     bool shouldBlinkOn() const;
-    
+
     // Get current display mode
     SyncManager::SyncState getCurrentUIState() const { return current_ui_state_; }
-    
+
     // Blink period configuration (ms)
     void setBlinkPeriod(uint16_t period_ms) { blink_period_ms_ = period_ms; }
     uint16_t getBlinkPeriod() const { return blink_period_ms_; }
 
 private:
+    static constexpr uint8_t WIDGET_COUNT = (uint8_t)Widget::COUNT;
+
     SyncManager::SyncState current_ui_state_;
     SyncManager::SyncState previous_ui_state_;
-    
-    // Dirty flags untuk setiap slice
-    uint8_t dirty_flags_;
-    
+
+    // Generation per widget: bumped on invalidate, copied on markDrawn
+    uint8_t gen_[WIDGET_COUNT];
+    uint8_t drawn_gen_[WIDGET_COUNT];
+
+    // Last seen link flags (noteData)
+    uint16_t last_sync_counter_;
+    uint8_t last_flags_;
+
     // Blinking logic untuk SYNC_LOSS
     BlinkState blink_state_;
     uint32_t blink_timestamp_;
     uint16_t blink_period_ms_;
     bool last_blink_on_;
-    
-    // Slice constants
-    static constexpr uint8_t SLICE_HEADER = 0;
-    static constexpr uint8_t SLICE_RPM = 1;
-    static constexpr uint8_t SLICE_ENGINE = 2;
-    static constexpr uint8_t SLICE_CONTROL = 3;
-    static constexpr uint8_t SLICE_FOOTER = 4;
-    static constexpr uint8_t SLICE_FULLSCREEN = 5;
-    
-    void markAllDirty_();
-    void clearAllDirty_();
+
     void updateBlinkState_();
 };
 
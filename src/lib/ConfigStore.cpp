@@ -0,0 +1,35 @@
+#include "ConfigStore.h"
+#include <EEPROM.h>
+
+uint8_t ConfigStore::checksum_(const uint8_t *data, uint8_t len) {
+    // Fletcher-style: catches swapped bytes as well as flipped bits
+    uint8_t a = len, b = 0;
+    for (uint8_t i = 0; i < len; ++i) {
+        a += data[i];
+        b += a;
+    }
+    return (uint8_t)(a ^ b);
+}
+
+bool ConfigStore::read_(Slot slot, void *data, uint8_t len) {
+    uint16_t addr = address_(slot);
+    if (EEPROM.read(addr) != MAGIC || EEPROM.read(addr + 1) != len) return false;
+    uint8_t buf[MAX_RECORD_DATA];
+    for (uint8_t i = 0; i < len; ++i) buf[i] = EEPROM.read(addr + 2 + i);
+    if (EEPROM.read(addr + 2 + len) != checksum_(buf, len)) return false;
+    memcpy(data, buf, len);
+    return true;
+}
+
+void ConfigStore::write_(Slot slot, const void *data, uint8_t len) {
+    uint16_t addr = address_(slot);
+    const uint8_t *bytes = (const uint8_t *)data;
+    EEPROM.update(addr, MAGIC);
+    EEPROM.update(addr + 1, len);
+    for (uint8_t i = 0; i < len; ++i) EEPROM.update(addr + 2 + i, bytes[i]);
+    EEPROM.update(addr + 2 + len, checksum_(bytes, len));
+}
+
+void ConfigStore::erase(Slot slot) {
+    EEPROM.update(address_(slot), 0xFF);
+}
@@ -0,0 +1,11 @@
+#include "Crc32.h"
+
+const Crc32::Table Crc32::TABLE PROGMEM = Crc32::Table();
+
+uint32_t Crc32::compute(const uint8_t *data, uint16_t len) {
+    uint32_t crc = INIT;
+    while (len--) {
+        crc = update(crc, *data++);
+    }
+    return finish(crc);
+}
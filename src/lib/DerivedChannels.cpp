@@ -0,0 +1,92 @@
+#include "DerivedChannels.h"
+
+DerivedChannels::DerivedChannels()
+    : stale_(0xFF),
+      evaluations_(0),
+      pw_us_(0),
+      rpm_(0),
+      afr_x100_(0),
+      fuel_acc_(0),
+      fuel_gap_ms_(0),
+      last_observe_ms_(0) {
+    memset(cache_, 0, sizeof(cache_));
+    // Defaults: 4 x 240 cc/min petrol, semi-sequential
+    config_.injector_cc_min = 240;
+    config_.injectors = 4;
+    config_.squirts_per_cycle = 2;
+    config_.dead_time_us = 1000;
+    config_.stoich_x100 = 1470;
+}
+
+void DerivedChannels::setConfig(const Config &config) {
+    config_ = config;
+    if (config_.stoich_x100 == 0) config_.stoich_x100 = 1470;
+    stale_ = 0xFF;
+}
+
+void DerivedChannels::observe(const ECUData &ecu_data) {
+    // Integrate the interval that just ended at the inputs held during it
+    uint32_t now = millis();
+    uint32_t dt = now - last_observe_ms_;
+    last_observe_ms_ = now;
+    uint32_t rate = (uint32_t)effectivePw_() * rpm_;
+    if (rate) {
+        // A long frame gap (lossy link, baud scan) counts MAX_STEP_MS at the
+        // held inputs; the rest is only recorded, not guessed
+        if (dt > MAX_STEP_MS) {
+            fuel_gap_ms_ += dt - MAX_STEP_MS;
+            dt = MAX_STEP_MS;
+        }
+        fuel_acc_ += (uint64_t)rate * dt;
+        stale_ |= (uint8_t)(1 << (uint8_t)Id::FUEL_USED);
+    }
+
+    ECUData::ChannelMask changed = ecu_data.changedChannels();
+    for (uint8_t i = 0; i < COUNT; ++i) {
+        if (changed & inputs((Id)i)) stale_ |= (uint8_t)(1 << i);
+    }
+    pw_us_ = ecu_data.pw1;
+    rpm_ = ecu_data.rpm;
+    afr_x100_ = ecu_data.afr;
+}
+
+int32_t DerivedChannels::get(Id id) {
+    uint8_t bit = (uint8_t)(1 << (uint8_t)id);
+    if (stale_ & bit) {
+        cache_[(uint8_t)id] = compute_(id);
+        stale_ &= (uint8_t)~bit;
+        evaluations_++;
+    }
+    return cache_[(uint8_t)id];
+}
+
+void DerivedChannels::resetFuelUsed() {
+    fuel_acc_ = 0;
+    fuel_gap_ms_ = 0;
+    stale_ |= (uint8_t)(1 << (uint8_t)Id::FUEL_USED);
+}
+
+uint16_t DerivedChannels::effectivePw_() const {
+    return pw_us_ > config_.dead_time_us ? (uint16_t)(pw_us_ - config_.dead_time_us) : 0;
+}
+
+int32_t DerivedChannels::compute_(Id id) const {
+    // K: cc/min delivered at 100 % duty by all injectors, per squirt slot
+    uint32_t k = (uint32_t)config_.injectors * config_.injector_cc_min * config_.squirts_per_cycle;
+    uint32_t pw_rpm = (uint32_t)effectivePw_() * rpm_;
+    switch (id) {
+        case Id::INJ_DUTY:
+            // pw[us] * squirts / (120e6 / rpm [us per cycle]) in 0.1 %
+            return (int32_t)((uint64_t)pw_rpm * config_.squirts_per_cycle / 120000UL);
+        case Id::FUEL_FLOW:
+            // cc/min = k * pw * rpm / 1.2e8; L/h x100 = cc/min * 6
+            return (int32_t)((uint64_t)pw_rpm * k / 20000000UL);
+        case Id::LAMBDA:
+            return (int32_t)((uint32_t)afr_x100_ * 1000UL / config_.stoich_x100);
+        case Id::FUEL_USED:
+            // L x100 = k * sum(pw * rpm * dt_ms) / (1.2e8 * 6e4 * 10)
+            return (int32_t)(fuel_acc_ / 1000000UL * k / 72000000UL);
+        default:
+            return 0;
+    }
+}
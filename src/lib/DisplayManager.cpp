@@ -6,12 +6,12 @@ DisplayManager::DisplayManager()
 
 bool DisplayManager::begin() {
     uint16_t ID = tft_.readID();
-    Serial.print("[TFT] readID = 0x"); Serial.println(ID, HEX);
+    Serial.print(F("[TFT] readID = 0x")); Serial.println(ID, HEX);
 
     // Beberapa shield bersifat write-only dan mengembalikan ID tidak valid.
     // Pakai fallback umum ILI9341 jika ID terdeteksi tidak masuk akal.
     if (ID == 0x0000 || ID == 0xFFFF || ID == 0xD3D3) {
-        Serial.println("[TFT] Unknown/Write-only ID, forcing 0x9341 (ILI9341)");
+        Serial.println(F("[TFT] Unknown/Write-only ID, forcing 0x9341 (ILI9341)"));
         ID = 0x9341;
     }
 
@@ -83,6 +83,11 @@ void DisplayManager::print(const char *text) {
     tft_.print(text);
 }
 
+void DisplayManager::print(const __FlashStringHelper *text) {
+    if (!initialized_) return;
+    tft_.print(text);
+}
+
 void DisplayManager::printf(const char *format, ...) {
     if (!initialized_) return;
     
@@ -111,9 +116,9 @@ void DisplayManager::printCentered(int16_t y, const char *text, Color fg, Color
 }
 
 void DisplayManager::debugPrintInfo() const {
-    Serial.println("\n=== DisplayManager ===");
-    Serial.print("Initialized: "); Serial.println(initialized_ ? "Yes" : "No");
-    Serial.print("Resolution: "); Serial.print(SCREEN_WIDTH); Serial.print("x"); Serial.println(SCREEN_HEIGHT);
+    Serial.println(F("\n=== DisplayManager ==="));
+    Serial.print(F("Initialized: ")); Serial.println(initialized_ ? F("Yes") : F("No"));
+    Serial.print(F("Resolution: ")); Serial.print(SCREEN_WIDTH); Serial.print(F("x")); Serial.println(SCREEN_HEIGHT);
 }
 
 void DisplayManager::drawBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h, Color border, Color fill) {
@@ -12,11 +12,60 @@ void ECUData::reset() {
     tps = 0;
     iat = 0;
     battery = 12000;  // 12V
+
+    advance = 0;
+    ve = 0;
+    afrTarget = 147;
+    afr2 = 147;
+    pw1 = 0;
+    tae = 0;
+    corrections = 100;
+    ego = 100;
+    baro = 101;
+    boostTarget = 0;
+    boostDuty = 0;
+    flex = 0;
+    rpmDot = 0;
+    tpsDot = 0;
+    vss = 0;
+    gear = 0;
     
     syncLossCounter = 0;
     isSynced = false;
     lastUpdateMillis = 0;
     isDataValid = false;
+
+    // Defaults differ from whatever consumers cached: redraw everything once
+    changed_ = CORE_CHANNELS | subscriptions_;
+}
+
+int32_t ECUData::value(Channel ch) const {
+    switch (ch) {
+        case Channel::RPM:          return rpm;
+        case Channel::MAP:          return map;
+        case Channel::TPS:          return (uint16_t)tps;
+        case Channel::CLT:          return (int16_t)clt;
+        case Channel::IAT:          return (int16_t)iat;
+        case Channel::AFR:          return (uint16_t)afr;
+        case Channel::BATTERY:      return (uint16_t)battery;
+        case Channel::ADVANCE:      return advance;
+        case Channel::VE:           return ve;
+        case Channel::AFR_TARGET:   return afrTarget;
+        case Channel::PW1:          return pw1;
+        case Channel::TAE:          return tae;
+        case Channel::CORRECTIONS:  return corrections;
+        case Channel::EGO:          return ego;
+        case Channel::BARO:         return baro;
+        case Channel::BOOST_TARGET: return (uint16_t)boostTarget;
+        case Channel::BOOST_DUTY:   return boostDuty;
+        case Channel::FLEX:         return flex;
+        case Channel::RPM_DOT:      return rpmDot;
+        case Channel::AFR2:         return afr2;
+        case Channel::TPS_DOT:      return tpsDot;
+        case Channel::VSS:          return (uint16_t)vss;
+        case Channel::GEAR:         return gear;
+        default:                    return 0;
+    }
 }
 
 bool ECUData::isStale(uint32_t timeout_ms) const {
@@ -25,16 +74,35 @@ bool ECUData::isStale(uint32_t timeout_ms) const {
 }
 
 void ECUData::debugPrint() const {
-    Serial.println("\n=== ECU Data ===");
-    Serial.print("RPM: "); Serial.println(rpm);
-    Serial.print("CLT: "); Serial.print(clt); Serial.println(" C");
-    Serial.print("AFR: "); Serial.print(afr/100.0); Serial.println(":1");
-    Serial.print("MAP: "); Serial.print(map); Serial.println(" kPa");
-    Serial.print("TPS: "); Serial.print(tps); Serial.println(" %");
-    Serial.print("IAT: "); Serial.print(iat); Serial.println(" C");
-    Serial.print("Battery: "); Serial.print(battery/1000.0); Serial.println(" V");
-    Serial.print("SyncLoss Counter: "); Serial.println(syncLossCounter);
-    Serial.print("Synced: "); Serial.println(isSynced ? "Yes" : "No");
-    Serial.print("Data Valid: "); Serial.println(isDataValid ? "Yes" : "No");
-    Serial.print("Stale: "); Serial.println(isStale() ? "Yes" : "No");
+    Serial.println(F("\n=== ECU Data ==="));
+    Serial.print(F("RPM: ")); Serial.println(rpm);
+    Serial.print(F("CLT: ")); Serial.print(clt); Serial.println(F(" C"));
+    Serial.print(F("AFR: ")); Serial.print(afr/100.0); Serial.println(F(":1"));
+    Serial.print(F("MAP: ")); Serial.print(map); Serial.println(F(" kPa"));
+    Serial.print(F("TPS: ")); Serial.print(tps); Serial.println(F(" %"));
+    Serial.print(F("IAT: ")); Serial.print(iat); Serial.println(F(" C"));
+    Serial.print(F("Battery: ")); Serial.print(battery/1000.0); Serial.println(F(" V"));
+    if (subscriptions_ & EXTENDED_CHANNELS) {
+        Serial.print(F("Subscribed: 0x")); Serial.println(subscriptions_, HEX);
+        if (isSubscribed(Channel::ADVANCE)) { Serial.print(F("Advance: ")); Serial.print(advance); Serial.println(F(" deg")); }
+        if (isSubscribed(Channel::VE)) { Serial.print(F("VE: ")); Serial.print(ve); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::AFR_TARGET)) { Serial.print(F("AFR Target: ")); Serial.print(afrTarget/10.0); Serial.println(F(":1")); }
+        if (isSubscribed(Channel::AFR2)) { Serial.print(F("AFR2: ")); Serial.print(afr2/10.0); Serial.println(F(":1")); }
+        if (isSubscribed(Channel::PW1)) { Serial.print(F("PW1: ")); Serial.print(pw1); Serial.println(F(" us")); }
+        if (isSubscribed(Channel::TAE)) { Serial.print(F("TAE: ")); Serial.print(tae); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::CORRECTIONS)) { Serial.print(F("Corrections: ")); Serial.print(corrections); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::EGO)) { Serial.print(F("EGO: ")); Serial.print(ego); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::BARO)) { Serial.print(F("Baro: ")); Serial.print(baro); Serial.println(F(" kPa")); }
+        if (isSubscribed(Channel::BOOST_TARGET)) { Serial.print(F("Boost Target: ")); Serial.print(boostTarget); Serial.println(F(" kPa")); }
+        if (isSubscribed(Channel::BOOST_DUTY)) { Serial.print(F("Boost Duty: ")); Serial.print(boostDuty); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::FLEX)) { Serial.print(F("Flex: ")); Serial.print(flex); Serial.println(F(" %")); }
+        if (isSubscribed(Channel::RPM_DOT)) { Serial.print(F("RPM/s: ")); Serial.println(rpmDot); }
+        if (isSubscribed(Channel::TPS_DOT)) { Serial.print(F("TPS/s: ")); Serial.println(tpsDot); }
+        if (isSubscribed(Channel::VSS)) { Serial.print(F("VSS: ")); Serial.print(vss); Serial.println(F(" km/h")); }
+        if (isSubscribed(Channel::GEAR)) { Serial.print(F("Gear: ")); Serial.println(gear); }
+    }
+    Serial.print(F("SyncLoss Counter: ")); Serial.println(syncLossCounter);
+    Serial.print(F("Synced: ")); Serial.println(isSynced ? F("Yes") : F("No"));
+    Serial.print(F("Data Valid: ")); Serial.println(isDataValid ? F("Yes") : F("No"));
+    Serial.print(F("Stale: ")); Serial.println(isStale() ? F("Yes") : F("No"));
 }
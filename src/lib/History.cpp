@@ -0,0 +1,114 @@
+#include "History.h"
+
+int8_t SessionHistory::slot_(ECUData::Channel ch) {
+    switch (ch) {
+        case ECUData::Channel::RPM: return 0;
+        case ECUData::Channel::MAP: return 1;
+        case ECUData::Channel::CLT: return 2;
+        case ECUData::Channel::AFR: return 3;
+        default:                    return -1;
+    }
+}
+
+#if ECU_HISTORY_BYTES > 0
+
+void SessionHistory::update(const ECUData &ecu_data) {
+    // isDataValid stays set after the first frame; a dropout shows as stale
+    if (ecu_data.isStale(ECU_HISTORY_STALE_MS)) return;
+    uint32_t now = millis();
+    if (rings_[0].size()) {
+        uint32_t dt = now - last_sample_ms_;
+        if (dt < ECU_HISTORY_PERIOD_MS) return;
+        // Periods without a sample (dropout, stalled loop) become a gap
+        uint32_t missed = (dt + ECU_HISTORY_PERIOD_MS / 2) / ECU_HISTORY_PERIOD_MS - 1;
+        if (missed) noteGap_(missed > 0xFFFF ? 0xFFFF : (uint16_t)missed);
+    }
+    last_sample_ms_ = now;
+    // RPM above 32767 does not happen on a piston engine; clamp anyway
+    uint16_t rpm = ecu_data.rpm;
+    rings_[0].append((int16_t)(rpm > 32767 ? 32767 : rpm));
+    rings_[1].append((int16_t)ecu_data.map);
+    rings_[2].append((int16_t)ecu_data.clt);
+    rings_[3].append((int16_t)(uint16_t)ecu_data.afr);
+    seq_++;
+}
+
+void SessionHistory::noteGap_(uint16_t periods) {
+    // A gap only times samples recorded before it; once every ring has
+    // dropped those, the entry can go
+    uint16_t kept = 0;
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+        if (rings_[i].size() > kept) kept = rings_[i].size();
+    }
+    uint8_t stale = 0;
+    while (stale < gap_count_ && gaps_[stale].seq <= seq_ - kept) stale++;
+    // Full: the oldest gap is forgotten and the samples before it untimed
+    if (stale == 0 && gap_count_ == MAX_GAPS) {
+        timed_from_ = gaps_[0].seq;
+        stale = 1;
+    }
+    if (stale) {
+        gap_count_ -= stale;
+        memmove(gaps_, gaps_ + stale, gap_count_ * sizeof(Gap));
+    }
+    gaps_[gap_count_++] = { seq_, periods };
+}
+
+void SessionHistory::clear() {
+    for (uint8_t i = 0; i < CHANNELS; ++i) rings_[i].clear();
+    seq_ = 0;
+    timed_from_ = 0;
+    gap_count_ = 0;
+}
+
+const SessionHistory::Ring *SessionHistory::ring(ECUData::Channel ch) const {
+    int8_t s = slot_(ch);
+    return s < 0 ? nullptr : &rings_[s];
+}
+
+int32_t SessionHistory::ageMs(uint16_t back) const {
+    if (back >= seq_) return -1;
+    uint32_t seq = seq_ - 1 - back;
+    if (seq < timed_from_) return -1;
+    uint32_t periods = back;
+    for (uint8_t g = gap_count_; g > 0 && gaps_[g - 1].seq > seq; --g) periods += gaps_[g - 1].periods;
+    return (int32_t)(periods * ECU_HISTORY_PERIOD_MS);
+}
+
+void SessionHistory::exportCsv(Print &out) const {
+    // Rings compress differently, so they hold different sample counts;
+    // rows are aligned on the newest sample and older gaps left empty.
+    // Rows older than the gap record are skipped (time unknown).
+    uint16_t rows = 0;
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+        if (rings_[i].size() > rows) rows = rings_[i].size();
+    }
+    Ring::Iterator it[CHANNELS] = { rings_[0].begin(), rings_[1].begin(),
+                                    rings_[2].begin(), rings_[3].begin() };
+    out.println(F("t_ms,rpm,map,clt,afr"));
+    for (uint16_t r = rows; r > 0; --r) {
+        int32_t age = ageMs(r - 1);
+        bool timed = age >= 0;
+        if (timed) out.print(-age);
+        for (uint8_t i = 0; i < CHANNELS; ++i) {
+            bool held = it[i].remaining() >= r;
+            if (timed) {
+                out.print(',');
+                if (held && i == 3) out.print((uint16_t)*it[i] / 100.0);
+                else if (held) out.print(*it[i]);
+            }
+            if (held) ++it[i];
+        }
+        if (timed) out.println();
+    }
+}
+
+#else
+
+void SessionHistory::update(const ECUData &) {}
+void SessionHistory::clear() {}
+const SessionHistory::Ring *SessionHistory::ring(ECUData::Channel) const { return nullptr; }
+int32_t SessionHistory::ageMs(uint16_t) const { return -1; }
+void SessionHistory::exportCsv(Print &out) const { out.println(F("[History] disabled")); }
+
+#endif
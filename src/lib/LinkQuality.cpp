@@ -0,0 +1,57 @@
+#include "LinkQuality.h"
+
+void LinkQuality::reset() {
+    last_frame_ms_ = 0;
+    interval_x16_ = 0;
+    jitter_x16_ = 0;
+    error_q16_ = 0;
+    frames_ = 0;
+}
+
+void LinkQuality::onFrame(uint32_t now_ms) {
+    if (frames_) {
+        uint32_t dt = now_ms - last_frame_ms_;
+        uint16_t dt_x16 = (uint16_t)(dt > 4000 ? 4000 * 16 : dt * 16);  // 4 s cap: keeps x16 in 16 bit
+        if (frames_ == 1) {
+            interval_x16_ = dt_x16;  // seed with the first real interval
+        } else {
+            int32_t dev = (int32_t)dt_x16 - interval_x16_;
+            interval_x16_ = (uint16_t)(interval_x16_ + (dev >> 3));
+            uint16_t abs_dev = (uint16_t)(dev < 0 ? -dev : dev);
+            jitter_x16_ = (uint16_t)(jitter_x16_ + (((int32_t)abs_dev - jitter_x16_) >> 3));
+        }
+    }
+    last_frame_ms_ = now_ms;
+    if (frames_ < 0xFF) frames_++;
+    error_(false);
+}
+
+void LinkQuality::onError() {
+    error_(true);
+}
+
+void LinkQuality::error_(bool failed) {
+    // Slower than the timing EWMAs (1/16): one lost frame alone moves the
+    // rate by ~6 %, so an isolated error does not read as an unhealthy link
+    int32_t target = failed ? 65535 : 0;
+    error_q16_ = (uint16_t)(error_q16_ + ((target - error_q16_) >> 4));
+}
+
+uint16_t LinkQuality::frameRateX10() const {
+    return interval_x16_ ? (uint16_t)(160000UL / interval_x16_) : 0;
+}
+
+uint32_t LinkQuality::timeoutMs(uint32_t floor_ms) const {
+    if (frames_ < 2) return floor_ms;  // no interval yet
+    uint32_t t = (uint32_t)intervalMs() * 2 + (uint32_t)jitterMs() * 4;
+    return t > floor_ms ? t : floor_ms;
+}
+
+void LinkQuality::debugPrint() const {
+    Serial.println(F("\n=== LinkQuality ==="));
+    Serial.print(F("Interval: ")); Serial.print(intervalMs());
+    Serial.print(F(" ms (+/- ")); Serial.print(jitterMs()); Serial.println(F(" ms)"));
+    Serial.print(F("Rate: ")); Serial.print(frameRateX10() / 10.0, 1); Serial.println(F(" Hz"));
+    Serial.print(F("Errors: ")); Serial.print(errorPercent()); Serial.println(F("%"));
+    Serial.print(F("Healthy: ")); Serial.println(isHealthy() ? F("Yes") : F("No"));
+}
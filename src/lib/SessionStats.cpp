@@ -0,0 +1,66 @@
+#include "SessionStats.h"
+#include <math.h>
+
+void SessionStats::reset() {
+    memset(acc_, 0, sizeof(acc_));
+    count_ = 0;
+}
+
+void SessionStats::update(const ECUData &ecu_data) {
+    // Engine off: idle-at-zero readings would only drag the means down
+    if (!ecu_data.isDataValid || ecu_data.rpm == 0) return;
+    bool first = count_ == 0;
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+        int32_t v = ecu_data.value((ECUData::Channel)i);
+        int16_t x = (int16_t)(v > 32767 ? 32767 : v);
+        Acc &a = acc_[i];
+        if (first) {
+            a.shift = a.min = a.max = x;
+            continue;  // d = 0: nothing to add
+        }
+        if (x < a.min) a.min = x;
+        if (x > a.max) a.max = x;
+        int32_t d = (int32_t)x - a.shift;
+        uint16_t ad = (uint16_t)(d < 0 ? -d : d);  // |d| <= 65535
+        uint32_t lo = a.sum_lo + (uint32_t)d;
+        a.sum_hi += (lo < a.sum_lo) - (d < 0);    // carry, sign extension
+        a.sum_lo = lo;
+        uint32_t sq = (uint32_t)ad * ad;          // 16x16 -> 32 multiply
+        lo = a.sumsq_lo + sq;
+        a.sumsq_hi += lo < sq;
+        a.sumsq_lo = lo;
+    }
+    count_++;
+}
+
+int32_t SessionStats::mean(ECUData::Channel ch) const {
+    if (!count_) return 0;
+    const Acc &a = acc_[(uint8_t)ch];
+    int64_t sum = a.sum();
+    int64_t half = sum >= 0 ? (int64_t)(count_ / 2) : -(int64_t)(count_ / 2);
+    return a.shift + (int32_t)((sum + half) / (int64_t)count_);
+}
+
+float SessionStats::variance(ECUData::Channel ch) const {
+    if (count_ < 2) return 0.0f;
+    const Acc &a = acc_[(uint8_t)ch];
+    float s = (float)a.sum();
+    float v = ((float)a.sumsq() - s * s / (float)count_) / (float)(count_ - 1);
+    return v > 0.0f ? v : 0.0f;
+}
+
+void SessionStats::dump(Print &out) const {
+    static const char NAMES[CHANNELS][4] PROGMEM = { "RPM", "MAP", "TPS", "CLT", "IAT", "AFR", "BAT" };
+    out.println(F("\n=== Session Stats ==="));
+    out.print(F("Samples: ")); out.println(count_);
+    if (!count_) return;
+    out.println(F("ch,min,max,mean,stddev"));
+    for (uint8_t i = 0; i < CHANNELS; ++i) {
+        ECUData::Channel ch = (ECUData::Channel)i;
+        out.print(reinterpret_cast<const __FlashStringHelper *>(NAMES[i])); out.print(',');
+        out.print(minimum(ch)); out.print(',');
+        out.print(maximum(ch)); out.print(',');
+        out.print(mean(ch)); out.print(',');
+        out.println(sqrt(variance(ch)));
+    }
+}
@@ -1,26 +1,68 @@
 #include "SpeeduinoParser.h"
+#include "Crc32.h"
+#include "ConfigStore.h"
+
+#if defined(__AVR__) && !defined(ECU_RX_NO_ISR)
+#include <avr/interrupt.h>
+#define ECU_RX_USE_ISR 1
+
+// Timer0 already ticks at ~1 kHz for millis(); its COMPA vector is free and
+// gives us a periodic hook to drain the 64-byte core UART buffer into our ring.
+static SpeeduinoParser *rx_owner = nullptr;
+
+ISR(TIMER0_COMPA_vect, ISR_NOBLOCK) {
+    if (rx_owner) rx_owner->serviceRx();
+}
+#endif
 
 SpeeduinoParser::SpeeduinoParser(uint32_t serial_baud)
         : serial_(nullptr),
             baud_rate_(serial_baud),
             state_(ParserState::IDLE),
-            buffer_index_(0),
             consecutive_errors_(0),
             line_index_(0),
             line_ready_(false),
             frames_received_(0),
             frames_errored_(0),
             sync_losses_(0) {
-        memset(frame_buffer_, 0, FRAME_SIZE);
         resetLineBuffer_();
-        memset(last_bytes_, 0, LAST_BYTES_CAP);
-        last_bytes_idx_ = 0;
+        setDefaultCsvSchema_();
+        memset(poll_groups_, 0, sizeof(poll_groups_));
+        configurePollGroup(0, ECUData::channelBit(ECUData::Channel::RPM) |
+                              ECUData::channelBit(ECUData::Channel::MAP) |
+                              ECUData::channelBit(ECUData::Channel::TPS) |
+                              ECUData::channelBit(ECUData::Channel::AFR), 0);
+        configurePollGroup(1, ECUData::channelBit(ECUData::Channel::CLT) |
+                              ECUData::channelBit(ECUData::Channel::IAT) |
+                              ECUData::channelBit(ECUData::Channel::BATTERY), 500);
 }
 
 void SpeeduinoParser::begin(HardwareSerial &serial) {
     serial_ = &serial;
+    #ifndef ECU_BAUD_FIXED
+    // Rate found on an earlier boot: start there, scan only if it stays quiet
+    baud_auto_ = true;
+    uint32_t stored_baud;
+    if (ConfigStore::load(ConfigStore::Slot::ECU_BAUD, stored_baud) && baudCandidateIndex_(stored_baud) != BAUD_NONE) {
+        baud_rate_ = stored_baud;
+    }
+    #endif
     serial_->begin(baud_rate_);
+    last_valid_ms_ = millis();
+    rx_.clear();
+    rx_seen_ = rx_.head();
+    protocol_ = Protocol::DETECT;
+    // CSV column map saved from an earlier header (or by setCsvSchema)
+    CsvSchema stored;
+    if (ConfigStore::load(ConfigStore::Slot::CSV_SCHEMA, stored)) setCsvSchema(stored);
+    scan_pos_ = 0;
     resetParserState_();
+    #ifdef ECU_RX_USE_ISR
+    rx_owner = this;
+    OCR0A = 0x80;               // mid-way between millis() overflow ticks
+    TIMSK0 |= _BV(OCIE0A);
+    rx_isr_ = true;
+    #endif
     // If compiled with request macros, configure defaults
     #ifdef USE_PRIMARY_REQUEST
     request_mode_ = true;
@@ -30,67 +72,254 @@ void SpeeduinoParser::begin(HardwareSerial &serial) {
     #ifdef PRIMARY_REQ_PERIOD_MS
     request_period_ms_ = (uint32_t)PRIMARY_REQ_PERIOD_MS;
     #endif
+    #ifdef PRIMARY_REQ_FRAMED
+    framed_requests_ = true;
+    #endif
     #endif
 }
 
+void SpeeduinoParser::serviceRx() {
+    if (!serial_) return;
+    // A failed push means the ring is full; the byte is counted as an overflow
+    while (serial_->available() > 0) {
+        if (!rx_.push((uint8_t)serial_->read())) break;
+    }
+}
+
 bool SpeeduinoParser::update(ECUData &ecu_data) {
     if (!serial_) return false;
+    if (!rx_isr_) serviceRx();
+
+    // Byte accounting (ring head is free-running, so the diff is the new bytes)
+    uint8_t head = rx_.head();
+    uint8_t fresh = (uint8_t)((head - rx_seen_) & RxRing<ECU_RX_RING_SIZE>::MASK);
+    if (fresh) {
+        raw_bytes_ += fresh;
+        last_rx_ms_ = millis();
+        rx_seen_ = head;
+    }
     
-    // Active polling if enabled
-    if (request_mode_) {
-        uint32_t now = millis();
-        if (now - last_request_ms_ >= request_period_ms_) {
-            serial_->write(&request_cmd_, 1);
+    // Active polling if enabled (pointless once locked to a streaming protocol)
+    serviceRequests_(ecu_data);
+
+    // Once locked, only the matching decoder looks at the bytes
+    bool got;
+    switch (protocol_) {
+        case Protocol::PRIMARY:     got = updatePrimary_(ecu_data); break;
+        case Protocol::FRAMED:      got = updateFramed_(ecu_data); break;
+        case Protocol::LEGACY_AA:   got = updateLegacy_(ecu_data); break;
+        case Protocol::GENERIC_CSV:
+        case Protocol::KEY_VALUE:   got = updateLine_(ecu_data); break;
+        case Protocol::DETECT:
+        default:                    got = updateDetect_(ecu_data); break;
+    }
+
+    // Pipelining: put the next request on the wire right behind the response
+    if (got && isRequestProtocol_()) serviceRequests_(ecu_data);
+    serviceBaudScan_();
+    return got;
+}
+
+// Candidate rates, most likely first. 230400/460800 need the ECU configured
+// for them; on 16 MHz AVRs both ends land on the same UBRR error.
+static const uint32_t BAUD_CANDIDATES[] PROGMEM = {
+    115200, 230400, 460800, 57600, 38400, 19200, 9600
+};
+static constexpr uint8_t BAUD_CANDIDATE_COUNT = sizeof(BAUD_CANDIDATES) / sizeof(BAUD_CANDIDATES[0]);
+
+uint8_t SpeeduinoParser::baudCandidateIndex_(uint32_t baud) {
+    for (uint8_t i = 0; i < BAUD_CANDIDATE_COUNT; ++i) {
+        if (pgm_read_dword(&BAUD_CANDIDATES[i]) == baud) return i;
+    }
+    return BAUD_NONE;
+}
+
+// Baud autodetect: a link with no decoded frame for BAUD_RESCAN_MS starts a
+// scan. Each candidate gets BAUD_DWELL_MS and is scored by decoded minus
+// rejected frames; BAUD_EARLY_LOCK valid frames lock it straight away,
+// otherwise the best non-zero score wins after a full pass.
+void SpeeduinoParser::serviceBaudScan_() {
+    if (!baud_auto_) return;
+    uint32_t now = millis();
+    if (data_frames_ != baud_seen_frames_) {
+        baud_seen_frames_ = data_frames_;
+        last_valid_ms_ = now;
+    }
+
+    if (!baud_scanning_) {
+        if (now - last_valid_ms_ < BAUD_RESCAN_MS) return;
+        Serial.println(F("[Parser] No valid data, scanning baud rates"));
+        baud_scanning_ = true;
+        baud_index_ = 0;
+        baud_best_score_ = 0;
+        baud_best_index_ = BAUD_NONE;
+        switchBaud_(pgm_read_dword(&BAUD_CANDIDATES[0]));
+        return;
+    }
+
+    int32_t score = (int32_t)(data_frames_ - baud_frames_mark_) - (int32_t)(frames_errored_ - baud_errors_mark_);
+    if (score >= BAUD_EARLY_LOCK) {
+        lockBaud_();
+        return;
+    }
+    if (now - baud_dwell_start_ < BAUD_DWELL_MS) return;
+
+    if (score > baud_best_score_) {
+        baud_best_score_ = (int16_t)score;
+        baud_best_index_ = baud_index_;
+    }
+    if (++baud_index_ < BAUD_CANDIDATE_COUNT) {
+        switchBaud_(pgm_read_dword(&BAUD_CANDIDATES[baud_index_]));
+    } else if (baud_best_index_ != BAUD_NONE) {
+        switchBaud_(pgm_read_dword(&BAUD_CANDIDATES[baud_best_index_]));
+        lockBaud_();
+    } else {
+        // Nothing intelligible at any rate: go round again
+        baud_index_ = 0;
+        switchBaud_(pgm_read_dword(&BAUD_CANDIDATES[0]));
+    }
+}
+
+void SpeeduinoParser::switchBaud_(uint32_t baud) {
+    baud_rate_ = baud;
+    #ifdef ECU_RX_USE_ISR
+    // The timer hook reads this UART: keep it out while the port re-clocks
+    TIMSK0 &= (uint8_t)~_BV(OCIE0A);
+    #endif
+    serial_->end();
+    serial_->begin(baud);
+    rx_.clear();
+    rx_seen_ = rx_.head();
+    #ifdef ECU_RX_USE_ISR
+    if (rx_isr_) TIMSK0 |= _BV(OCIE0A);
+    #endif
+    protocol_ = Protocol::DETECT;
+    link_.reset();  // new rate, new link
+    expect_primary_ = false;
+    scan_pos_ = 0;
+    resetParserState_();
+    resetLineBuffer_();
+    baud_dwell_start_ = millis();
+    baud_frames_mark_ = data_frames_;
+    baud_errors_mark_ = frames_errored_;
+}
+
+void SpeeduinoParser::lockBaud_() {
+    baud_scanning_ = false;
+    last_valid_ms_ = millis();
+    ConfigStore::save(ConfigStore::Slot::ECU_BAUD, baud_rate_);  // no-op when unchanged
+    Serial.print(F("[Parser] Baud locked: "));
+    Serial.println(baud_rate_);
+}
+
+// Request engine: one request in flight, next one sent as soon as the
+// previous response completes (PRIMARY lock), adaptive timeout from the
+// measured ECU turnaround, bounded retries. All deadlines are wrap-safe.
+void SpeeduinoParser::serviceRequests_(ECUData &ecu_data) {
+    if (!request_mode_) return;
+    if (protocol_ != Protocol::DETECT && !isRequestProtocol_()) return;
+    uint32_t now = millis();
+    subscribed_ = ecu_data.subscriptions() & ECUData::EXTENDED_CHANNELS;
+
+    if (expect_primary_) {
+        if (!timeReached_(now, primary_expect_deadline_)) return;
+        // No (complete) answer in time
+        expect_primary_ = false;
+        pipeline_ready_ = false;
+        request_timeouts_++;
+        if (!isRequestProtocol_()) {
+            // Detecting: leave buffered bytes to the stream scanner, which
+            // only runs with no request in flight; restart the gap so it
+            // gets a full period before the next request goes out
+            retry_count_ = 0;
             last_request_ms_ = now;
-            // Expect a primary response shortly after
-            expect_primary_ = true;
-            primary_expect_deadline_ = now + 150; // 150ms window
+            return;
+        } else {
+            rx_.clear();
+            if (retry_count_ < MAX_REQUEST_RETRIES) {
+                // Retry right away; a single lost reply is not an error yet
+                retry_count_++;
+                request_retries_++;
+                issueRequest_(now);
+                return;
+            }
+            // Counts toward falling back to detection
+            retry_count_ = 0;
+            onFrameError_(ecu_data, RejectReason::TIMEOUT);
         }
     }
-    
-    // If expecting a primary response (74 bytes, no header), capture aligned buffer
+
+    // Back-to-back after a good response, otherwise the configured period
+    uint32_t gap = pipeline_ready_ ? request_min_gap_ms_ : request_period_ms_;
+    if (now - last_request_ms_ >= gap) {
+        if (isRequestProtocol_()) rx_.clear();  // stale bytes would misalign the reply
+        issueRequest_(now);
+    }
+}
+
+void SpeeduinoParser::issueRequest_(uint32_t now) {
+    last_request_ms_ = now;
+    pipeline_ready_ = false;
+    if (sendRequest_(now)) {
+        // Expect a primary response shortly after
+        expect_primary_ = true;
+        request_sent_us_ = micros();
+        primary_expect_deadline_ = now + responseTimeoutMs_();
+    }
+}
+
+uint32_t SpeeduinoParser::responseTimeoutMs_() const {
+    if (!rtt_ewma_us_) return PRIMARY_TIMEOUT_MS;  // nothing measured yet
+    // Twice the smoothed turnaround plus margin for a loop stalled by rendering
+    uint32_t t = (rtt_ewma_us_ * 2) / 1000 + RESPONSE_TIMEOUT_MARGIN_MS;
+    if (t < RESPONSE_TIMEOUT_MIN_MS) t = RESPONSE_TIMEOUT_MIN_MS;
+    if (t > PRIMARY_TIMEOUT_MS) t = PRIMARY_TIMEOUT_MS;
+    return t;
+}
+
+void SpeeduinoParser::noteResponse_() {
+    // Turnaround from request to complete response, EWMA with alpha = 1/8
+    uint32_t rtt = micros() - request_sent_us_;
+    if (!rtt_ewma_us_) rtt_ewma_us_ = rtt;
+    else rtt_ewma_us_ = rtt_ewma_us_ + ((int32_t)(rtt - rtt_ewma_us_) >> 3);
+    retry_count_ = 0;
+}
+
+// Autodetect: feed every byte to all decoders, lock once one wins repeatedly
+bool SpeeduinoParser::updateDetect_(ECUData &ecu_data) {
+    // If expecting a primary response (74 bytes, no header), it starts at the
+    // ring tail; decode it in place once complete
     if (expect_primary_) {
-        // Incrementally collect up to PRIMARY_RESPONSE_SIZE bytes
-        while (serial_->available() && buffer_index_ < PRIMARY_RESPONSE_SIZE) {
-            frame_buffer_[buffer_index_++] = serial_->read();
-        }
-        if (buffer_index_ >= PRIMARY_RESPONSE_SIZE) {
-            state_ = ParserState::FRAME_READY;
-            expect_primary_ = false;
-        } else if (millis() > primary_expect_deadline_) {
-            // timeout window passed; stop expecting primary and reset buffer
-            expect_primary_ = false;
-            buffer_index_ = 0;
-        }
+        // New protocol: the envelope tells us exactly where the answer is;
+        // headerless: best plausible alignment. On timeout serviceRequests_()
+        // hands buffered bytes to the stream scanner.
+        int8_t r = framed_requests_ ? pollFramedResponse_(ecu_data) : pollPrimaryResponse_(ecu_data);
+        if (r > 0) noteDetected_(framed_requests_ ? Protocol::FRAMED : Protocol::PRIMARY);
+        return r > 0;
     }
 
-    // Non-blocking read dari serial buffer
-    while (serial_->available()) {
-        uint8_t byte = serial_->read();
-        raw_bytes_++;
-        last_rx_ms_ = millis();
-        // keep last bytes for debug
-        last_bytes_[last_bytes_idx_] = byte;
-        last_bytes_idx_ = (last_bytes_idx_ + 1) % LAST_BYTES_CAP;
+    // Non-blocking scan of unread ring bytes (nothing is consumed until
+    // a frame or line completes)
+    uint8_t avail = rx_.available();
+    while (!expect_primary_ && state_ != ParserState::FRAME_READY && !line_ready_ && scan_pos_ < avail) {
+        uint8_t byte = rx_.peek(scan_pos_);
 
         switch (state_) {
             case ParserState::IDLE:
                 if (byte == FRAME_HEADER) {
-                    frame_buffer_[0] = byte;
-                    buffer_index_ = 1;
+                    frame_off_ = scan_pos_;
                     state_ = ParserState::HEADER_FOUND;
                 }
                 break;
             
             case ParserState::HEADER_FOUND:
             case ParserState::COLLECTING_DATA:
-                if (buffer_index_ < FRAME_SIZE) {
-                    frame_buffer_[buffer_index_++] = byte;
-                    state_ = ParserState::COLLECTING_DATA;
-                    
-                    if (buffer_index_ >= FRAME_SIZE) {
-                        state_ = ParserState::FRAME_READY;
-                    }
+                state_ = ParserState::COLLECTING_DATA;
+                if ((uint8_t)(scan_pos_ - frame_off_) + 1 >= FRAME_SIZE) {
+                    frame_len_ = FRAME_SIZE;
+                    frame_base_ = 0;
+                    frame_mask_ = ECUData::CORE_CHANNELS;
+                    state_ = ParserState::FRAME_READY;
                 }
                 break;
             
@@ -100,145 +329,414 @@ bool SpeeduinoParser::update(ECUData &ecu_data) {
         }
 
         // Collect ASCII CSV for Secondary Serial Generic Fixed
-        if (byte == '\n' || byte == '\r') {
-            if (line_index_ > 0) {
-                line_buffer_[line_index_] = '\0';
-                line_ready_ = true;
-            }
-        } else if (line_index_ < LINE_BUFFER_SIZE - 1) {
-            if ((byte >= 32 && byte <= 126) || byte == '\t') {
-                line_buffer_[line_index_++] = (char)byte;
-            }
-        } else {
-            // Overflow; reset
-            resetLineBuffer_();
-        }
+        collectLineByte_(byte);
+        scan_pos_++;
     }
     
     // Check if frame ready dan validate
     if (state_ == ParserState::FRAME_READY) {
-        if (validateFrame_()) {
-            extractDataFromFrame_(ecu_data);
-            frames_received_++;
-            consecutive_errors_ = 0;
-            // If binary status bit does not indicate sync, allow
-            // a safe fallback after a few good frames with plausible data
-            if (!ecu_data.isSynced) {
-                valid_streak_++;
-                if (valid_streak_ >= 3 && ecu_data.rpm > 0) {
-                    ecu_data.isSynced = true; // treat as synced
-                }
-            } else {
-                valid_streak_ = 0;
-            }
-            resetParserState_();
-            resetLineBuffer_();
-            return true;
-        } else {
-            frames_errored_++;
-            consecutive_errors_++;
-            valid_streak_ = 0;
-            
-            if (consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
-                sync_losses_++;
-                ecu_data.syncLossCounter++;
-                ecu_data.isSynced = false;
-                consecutive_errors_ = 0;
-            }
-            
-            resetParserState_();
-            resetLineBuffer_();
-            return false;
-        }
+        Protocol kind = (frame_len_ == FRAME_SIZE) ? Protocol::LEGACY_AA : Protocol::PRIMARY;
+        uint8_t consumed = (uint8_t)(frame_off_ + frame_len_);
+        if (consumed < scan_pos_) consumed = scan_pos_;
+        bool ok = finishFrame_(ecu_data, consumed);
+        resetLineBuffer_();
+        if (ok) noteDetected_(kind);
+        return ok;
     }
 
+    // Line bytes are copied out already; keep only a pending binary frame
+    releaseScanned_();
+
     // If no binary frame, try ASCII line parsing (key=value or generic CSV)
     if (line_ready_) {
         bool has_eq = false;
         for (uint16_t i = 0; i < line_index_; ++i) { if (line_buffer_[i] == '=') { has_eq = true; break; } }
-        bool ok = false;
-        if (has_eq) {
-            ok = extractDataFromKeyValue_(ecu_data, line_buffer_);
-        } else {
-            ok = extractDataFromGenericFixed_(ecu_data, line_buffer_);
+        Protocol kind = has_eq ? Protocol::KEY_VALUE : Protocol::GENERIC_CSV;
+        bool ok = finishLine_(ecu_data, kind);
+        if (ok) noteDetected_(kind);
+        return ok;
+    }
+    
+    return false;
+}
+
+// Locked to primary 'A' request/response: bytes outside a response window are noise
+bool SpeeduinoParser::updatePrimary_(ECUData &ecu_data) {
+    if (!expect_primary_) {
+        rx_.clear();
+        return false;
+    }
+    int8_t r = pollPrimaryResponse_(ecu_data);
+    pipeline_ready_ = r > 0;
+    return r > 0;
+}
+
+// Raw realtime-block limits per core channel (indexed by Channel):
+// physical range and largest believable change between two responses
+struct ResyncLimit { int16_t lo; int16_t hi; int16_t step; };
+static const ResyncLimit RESYNC_LIMITS[] PROGMEM = {
+    { 0, 15000, 4000 },     // RPM
+    { 0, 600, 150 },        // MAP (kPa)
+    { 0, 100, 100 },        // TPS (%)
+    { -40, 127, 5 },        // CLT (°C)
+    { -40, 127, 10 },       // IAT (°C)
+    { 0, 250, 80 },         // AFR (x10, 0 = no sensor)
+    { 0, 160, 20 },         // BATTERY (0.1 V)
+};
+static_assert(sizeof(RESYNC_LIMITS) / sizeof(RESYNC_LIMITS[0]) == (uint8_t)ECUData::Channel::BATTERY + 1,
+              "one resync limit per core channel");
+
+int16_t SpeeduinoParser::resyncRaw_(uint8_t ch, const rt::FieldSpan &f) const {
+    if (f.width == 2) return (int16_t)frameWord_(f.offset);
+    if (ch == (uint8_t)ECUData::Channel::CLT || ch == (uint8_t)ECUData::Channel::IAT) {
+        return (int8_t)frameByte_(f.offset);
+    }
+    return frameByte_(f.offset);
+}
+
+// Score of the candidate described by frame_*: +2 per core channel inside its
+// physical range, +/-1 for the change since the last accepted response.
+// Any channel out of range rules the alignment out.
+int16_t SpeeduinoParser::scoreAlignment_() const {
+    int16_t score = 0;
+    for (uint8_t ch = 0; ch < RESYNC_CHANNELS; ++ch) {
+        const rt::FieldSpan &f = RealtimeLayout::SPANS.v[ch];
+        if (f.width == 0 || !frameHas_(f.offset, f.width)) continue;
+        int16_t v = resyncRaw_(ch, f);
+        int16_t lo = (int16_t)pgm_read_word(&RESYNC_LIMITS[ch].lo);
+        int16_t hi = (int16_t)pgm_read_word(&RESYNC_LIMITS[ch].hi);
+        if (v < lo || v > hi) return RESYNC_REJECT;
+        score += 2;
+        if (resync_prev_valid_ & (1 << ch)) {
+            int16_t d = v - resync_prev_[ch];
+            if (d < 0) d = -d;
+            score += (d <= (int16_t)pgm_read_word(&RESYNC_LIMITS[ch].step)) ? 1 : -1;
         }
-        resetLineBuffer_();
-        if (ok) {
-            frames_received_++;
-            consecutive_errors_ = 0;
-            ecu_data.isSynced = true;
-            valid_streak_ = 0;
-            return true;
-        } else {
-            frames_errored_++;
-            consecutive_errors_++;
-            valid_streak_ = 0;
-            if (consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
-                sync_losses_++;
-                ecu_data.syncLossCounter++;
-                ecu_data.isSynced = false;
-                consecutive_errors_ = 0;
-            }
-            return false;
+    }
+    return score;
+}
+
+// Headerless primary/'r' response at the ring tail. A dropped or stray byte
+// shifts every field, so instead of decoding offset 0 blindly the candidate
+// alignments (0..RESYNC_MAX_SHIFT, plus "the newest response_len_ bytes")
+// are scored and the best plausible one is decoded in place.
+// Returns 0 while waiting, 1 on a decoded frame, -1 on a rejected one.
+int8_t SpeeduinoParser::pollPrimaryResponse_(ECUData &ecu_data) {
+    uint8_t avail = rx_.available();
+    if (avail < response_len_) return 0;  // timeouts: serviceRequests_()
+    uint8_t extra = (uint8_t)(avail - response_len_);
+
+    frame_len_ = response_len_;
+    frame_base_ = response_base_;
+    frame_mask_ = response_mask_;
+    int16_t best = RESYNC_REJECT;
+    uint8_t best_shift = 0;
+    for (uint8_t s = 0; s <= extra; ++s) {
+        if (s > RESYNC_MAX_SHIFT && s != extra) continue;
+        frame_off_ = s;
+        int16_t score = scoreAlignment_();
+        if (score > best) {
+            best = score;
+            best_shift = s;
+        }
+    }
+
+    if (best == RESYNC_REJECT) {
+        frame_off_ = 0;
+        // The real response may still be arriving behind a few stray bytes
+        if (extra < RESYNC_MAX_SHIFT) return 0;
+        expect_primary_ = false;
+        rx_.clear();
+        onFrameError_(ecu_data, RejectReason::PLAUSIBILITY);
+        return -1;
+    }
+
+    expect_primary_ = false;
+    noteResponse_();
+    if (best_shift) resyncs_++;
+    frame_off_ = best_shift;
+    // Reference for the next rate-of-change check
+    for (uint8_t ch = 0; ch < RESYNC_CHANNELS; ++ch) {
+        const rt::FieldSpan &f = RealtimeLayout::SPANS.v[ch];
+        if (f.width == 0 || !frameHas_(f.offset, f.width)) continue;
+        resync_prev_[ch] = resyncRaw_(ch, f);
+        resync_prev_valid_ |= (uint8_t)(1 << ch);
+    }
+    return finishFrame_(ecu_data, (uint8_t)(best_shift + response_len_)) ? 1 : -1;
+}
+
+// Locked to the new serial protocol: length + payload + CRC32 envelope
+bool SpeeduinoParser::updateFramed_(ECUData &ecu_data) {
+    if (!expect_primary_) {
+        rx_.clear();
+        return false;
+    }
+    int8_t r = pollFramedResponse_(ecu_data);
+    pipeline_ready_ = r > 0;
+    return r > 0;
+}
+
+// Envelope: [len BE16][rc + data][CRC32 BE of rc + data].
+// Returns 0 while incomplete, 1 on a decoded frame, -1 on a rejected one.
+int8_t SpeeduinoParser::pollFramedResponse_(ECUData &ecu_data) {
+    uint8_t avail = rx_.available();
+    if (avail < 2) return 0;
+    uint16_t n = ((uint16_t)rx_.peek(0) << 8) | rx_.peek(1);
+    if (n != (uint16_t)response_len_ + 1) {
+        // Wrong size for what we asked: nothing in this burst can be trusted
+        expect_primary_ = false;
+        rx_.clear();
+        onFrameError_(ecu_data, RejectReason::LENGTH);
+        return -1;
+    }
+    uint8_t total = (uint8_t)(n + FRAMED_OVERHEAD);
+    if (avail < total) return 0;
+    expect_primary_ = false;
+    noteResponse_();
+
+    // CRC over the payload, straight out of the ring
+    uint32_t crc = Crc32::INIT;
+    for (uint8_t i = 0; i < n; ++i) {
+        crc = Crc32::update(crc, rx_.peek((uint8_t)(2 + i)));
+    }
+    crc = Crc32::finish(crc);
+    uint8_t c = (uint8_t)(2 + n);
+    uint32_t rx_crc = ((uint32_t)rx_.peek(c) << 24) | ((uint32_t)rx_.peek((uint8_t)(c + 1)) << 16) |
+                      ((uint32_t)rx_.peek((uint8_t)(c + 2)) << 8) | rx_.peek((uint8_t)(c + 3));
+    if (crc != rx_crc) {
+        rx_.skip(total);
+        onFrameError_(ecu_data, RejectReason::CRC);
+        return -1;
+    }
+    if (rx_.peek(2) != SERIAL_RC_OK) {
+        rx_.skip(total);
+        onFrameError_(ecu_data, RejectReason::RETURN_CODE);
+        return -1;
+    }
+    frame_off_ = 3;  // skip length + return code
+    frame_len_ = response_len_;
+    frame_base_ = response_base_;
+    frame_mask_ = response_mask_;
+    return finishFrame_(ecu_data, total) ? 1 : -1;
+}
+
+// Locked to the 0xAA stream: hunt the header at the ring tail, then wait for the frame
+bool SpeeduinoParser::updateLegacy_(ECUData &ecu_data) {
+    uint8_t avail = rx_.available();
+    for (;;) {
+        while (avail && rx_.peek(0) != FRAME_HEADER) {
+            dropLegacyByte_(ecu_data);
+            avail--;
+        }
+        if (avail < FRAME_SIZE) return false;
+
+        // Joining mid-stream, a data byte of 0xAA looks like a header. Once the
+        // next frame has started its header must sit exactly FRAME_SIZE later,
+        // and the candidate must decode to plausible values; otherwise slide
+        // one byte and hunt again instead of dropping a whole frame.
+        frame_off_ = 0;
+        frame_len_ = FRAME_SIZE;
+        frame_base_ = 0;
+        frame_mask_ = ECUData::CORE_CHANNELS;
+        bool next_ok = avail <= FRAME_SIZE || rx_.peek((uint8_t)FRAME_SIZE) == FRAME_HEADER;
+        if (next_ok && validateFrame_()) break;
+        dropLegacyByte_(ecu_data);
+        avail--;
+    }
+    garbage_bytes_ = 0;
+    return finishFrame_(ecu_data, FRAME_SIZE);
+}
+
+void SpeeduinoParser::dropLegacyByte_(ECUData &ecu_data) {
+    rx_.skip(1);
+    // A full frame worth of bytes without a header means we lost the stream
+    if (++garbage_bytes_ >= FRAME_SIZE) {
+        garbage_bytes_ = 0;
+        onFrameError_(ecu_data, RejectReason::NO_HEADER);
+    }
+}
+
+// Locked to an ASCII protocol: bytes go to the line collector only
+bool SpeeduinoParser::updateLine_(ECUData &ecu_data) {
+    while (rx_.available()) {
+        if (collectLineByte_(rx_.pop())) {
+            return finishLine_(ecu_data, protocol_);
         }
     }
-    
     return false;
 }
 
+bool SpeeduinoParser::collectLineByte_(uint8_t byte) {
+    if (byte == '\n' || byte == '\r') {
+        if (line_index_ > 0) {
+            line_buffer_[line_index_] = '\0';
+            line_ready_ = true;
+        }
+    } else if (line_index_ < LINE_BUFFER_SIZE - 1) {
+        if ((byte >= 32 && byte <= 126) || byte == '\t') {
+            line_buffer_[line_index_++] = (char)byte;
+        }
+    } else {
+        // Overflow; reset
+        resetLineBuffer_();
+    }
+    return line_ready_;
+}
+
+bool SpeeduinoParser::finishFrame_(ECUData &ecu_data, uint8_t consumed) {
+    bool valid = validateFrame_();
+    if (valid) {
+        extractDataFromFrame_(ecu_data);
+        data_frames_++;
+    }
+    // Release the frame (and anything scanned before it) back to the ISR
+    rx_.skip(consumed);
+    scan_pos_ = 0;
+    resetParserState_();
+
+    if (!valid) {
+        onFrameError_(ecu_data, RejectReason::PLAUSIBILITY);
+        return false;
+    }
+    frames_received_++;
+    consecutive_errors_ = 0;
+    link_.onFrame(millis());
+    // If binary status bit does not indicate sync, allow a safe fallback
+    // once the link itself is healthy and the data is plausible
+    if (!ecu_data.isSynced && link_.isHealthy() && ecu_data.rpm > 0) {
+        ecu_data.isSynced = true; // treat as synced
+    }
+    return true;
+}
+
+bool SpeeduinoParser::finishLine_(ECUData &ecu_data, Protocol kind) {
+    if (kind == Protocol::GENERIC_CSV && learnCsvHeader_(line_buffer_)) {
+        // Column names, not data: schema updated, nothing to decode
+        resetLineBuffer_();
+        return false;
+    }
+    bool ok = (kind == Protocol::KEY_VALUE)
+        ? extractDataFromKeyValue_(ecu_data, line_buffer_)
+        : extractDataFromGenericFixed_(ecu_data, line_buffer_);
+    resetLineBuffer_();
+    if (!ok) {
+        onFrameError_(ecu_data, RejectReason::PARSE);
+        return false;
+    }
+    frames_received_++;
+    data_frames_++;
+    consecutive_errors_ = 0;
+    link_.onFrame(millis());
+    ecu_data.isSynced = true;
+    return true;
+}
+
+void SpeeduinoParser::onFrameError_(ECUData &ecu_data, RejectReason reason) {
+    frames_errored_++;
+    if (reject_counts_[(uint8_t)reason] != 0xFFFF) reject_counts_[(uint8_t)reason]++;
+    consecutive_errors_++;
+    link_.onError();
+    if (consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
+        sync_losses_++;
+        ecu_data.syncLossCounter++;
+        ecu_data.isSynced = false;
+        consecutive_errors_ = 0;
+        // The locked decoder keeps failing: go back to autodetect
+        if (protocol_ != Protocol::DETECT) lockProtocol_(Protocol::DETECT);
+    }
+}
+
+void SpeeduinoParser::noteDetected_(Protocol kind) {
+    if (kind != detect_candidate_) {
+        detect_candidate_ = kind;
+        detect_hits_ = 0;
+    }
+    if (++detect_hits_ >= DETECT_LOCK_FRAMES) {
+        lockProtocol_(kind);
+    }
+}
+
+void SpeeduinoParser::lockProtocol_(Protocol proto) {
+    protocol_ = proto;
+    detect_candidate_ = Protocol::DETECT;
+    detect_hits_ = 0;
+    garbage_bytes_ = 0;
+    scan_pos_ = 0;
+    resetParserState_();
+    resetLineBuffer_();
+    Serial.print(F("[Parser] Protocol: "));
+    Serial.println(getProtocolString());
+}
+
+const char* SpeeduinoParser::getProtocolString() const {
+    switch (protocol_) {
+        case Protocol::DETECT:      return "DETECT";
+        case Protocol::PRIMARY:     return "PRIMARY";
+        case Protocol::FRAMED:      return "FRAMED";
+        case Protocol::LEGACY_AA:   return "LEGACY_AA";
+        case Protocol::GENERIC_CSV: return "GENERIC_CSV";
+        case Protocol::KEY_VALUE:   return "KEY_VALUE";
+        default:                    return "UNKNOWN";
+    }
+}
+
+void SpeeduinoParser::releaseScanned_() {
+    if (state_ == ParserState::IDLE) {
+        rx_.skip(scan_pos_);
+        scan_pos_ = 0;
+    } else if (frame_off_ > 0) {
+        // Keep the partial frame, drop what precedes its header
+        rx_.skip(frame_off_);
+        scan_pos_ -= frame_off_;
+        frame_off_ = 0;
+    }
+}
+
 bool SpeeduinoParser::validateFrame_() const {
-    // Check for primary response format (74 bytes, no header)
-    // or binary frame format (128 bytes, header 0xAA)
-    
-    if (buffer_index_ >= PRIMARY_RESPONSE_SIZE && frame_buffer_[0] != FRAME_HEADER) {
-        // Likely a primary response (no 0xAA header)
-        // Basic sanity: check RPM and battery range
-        uint16_t rpm = (frame_buffer_[OFFSET_RPM_HI] << 8) | frame_buffer_[OFFSET_RPM_LO];
+    // Binary frame format (128 bytes with 0xAA header), otherwise a
+    // primary response or 'r' window into it (no header)
+    if (frame_len_ == FRAME_SIZE) {
+        if (frameByte_(0) != FRAME_HEADER) return false;
+        if (frameWord_(LEGACY_OFFSET_RPM) > 15000) return false;
+        if (frameByte_(LEGACY_OFFSET_BATTERY) > 160) return false;  // > 16V unrealistic
+        if (frameByte_(LEGACY_OFFSET_TPS) > 100) return false;
+        uint16_t afr = frameWord_(LEGACY_OFFSET_AFR);
+        return afr == 0 || (afr >= 500 && afr <= 2500);
+    }
+    if (frame_len_ == 0) return false;
+
+    // Basic sanity: check RPM and battery range (when in the window)
+    if (frameHas_(OFFSET_RPM_LO, 2)) {
+        uint16_t rpm = frameWord_(OFFSET_RPM_LO);
         if (rpm > 15000) return false;
-        
-        uint8_t battery_raw = frame_buffer_[OFFSET_BATTERY];
+    }
+    if (frameHas_(OFFSET_BATTERY, 1)) {
+        uint8_t battery_raw = frameByte_(OFFSET_BATTERY);
         if (battery_raw > 160) return false;  // > 16V unrealistic
-        
-        return true;
-    } else if (buffer_index_ >= FRAME_SIZE && frame_buffer_[0] == FRAME_HEADER) {
-        // Binary frame format (128 bytes with 0xAA header)
-        return true;
     }
-    
-    return false;
+    return true;
 }
 
 void SpeeduinoParser::extractDataFromFrame_(ECUData &ecu_data) {
-    // Parse primary response format (74 bytes, no header)
-    if (buffer_index_ >= PRIMARY_RESPONSE_SIZE && frame_buffer_[0] != FRAME_HEADER) {
-        // Primary realtime response (Speeduino 3.5+)
-        
-        // MAP: offset 4-5, 2 byte little-endian (kPa)
-        uint16_t map_raw = (frame_buffer_[OFFSET_MAP_HI] << 8) | frame_buffer_[OFFSET_MAP_LO];
-        ecu_data.map = map_raw >> 8;  // Simplify to byte range for display
-        
-        // CLT: offset 7, 1 byte signed (°C)
-        ecu_data.clt = (int8_t)frame_buffer_[OFFSET_CLT];
-        
-        // IAT: offset 6, 1 byte signed (°C)
-        ecu_data.iat = (int8_t)frame_buffer_[OFFSET_IAT];
-        
-        // Battery: offset 9, 1 byte (0.1V per unit), convert to mV
-        ecu_data.battery = frame_buffer_[OFFSET_BATTERY] * 100;
-        
-        // AFR: offset 10, 1 byte (AFR/10, e.g., 147 = 14.7), scale to 100x
-        ecu_data.afr = (uint16_t)frame_buffer_[OFFSET_AFR] * 10;
-        
-        // RPM: offset 14-15, 2 byte little-endian
-        ecu_data.rpm = (frame_buffer_[OFFSET_RPM_HI] << 8) | frame_buffer_[OFFSET_RPM_LO];
-        
-        // TPS: offset 24, 1 byte (%)
-        ecu_data.tps = frame_buffer_[OFFSET_TPS];
+    if (frame_len_ == FRAME_SIZE) {
+        // Legacy 0xAA stream (older ECUs): same unrolled decoder, own layout
+        LegacyLayout::decode(FrameView{ *this }, ecu_data, ECUData::CORE_CHANNELS);
+        ecu_data.isSynced = (frameByte_(LEGACY_OFFSET_STATUS) & 0x01) != 0;
+    } else {
+        // Primary realtime response (Speeduino 3.5+), full or 'r' window;
+        // channels outside the window (or not due this slot) keep their value
+
+        // Extended channels only when a consumer subscribed (lazy decode)
+        ECUData::ChannelMask mask = frame_mask_ & (ECUData::CORE_CHANNELS | ecu_data.subscriptions());
+        RealtimeLayout::decode(FrameView{ *this }, ecu_data, mask);
         
         ecu_data.isSynced = true;  // Primary response = synced
-    } else if (buffer_index_ >= FRAME_SIZE && frame_buffer_[0] == FRAME_HEADER) {
-        // Binary frame format (128 bytes) - for backward compatibility
-        ecu_data.isSynced = false;
+
+        // Groups carried by this response are fresh again
+        uint32_t now = millis();
+        for (uint8_t g = 0; g < MAX_POLL_GROUPS; ++g) {
+            if (response_groups_ & (1 << g)) poll_groups_[g].last_ms = now;
+        }
     }
     
     // Update timestamps
@@ -248,7 +746,129 @@ void SpeeduinoParser::extractDataFromFrame_(ECUData &ecu_data) {
 
 void SpeeduinoParser::resetParserState_() {
     state_ = ParserState::IDLE;
-    buffer_index_ = 0;
+    frame_off_ = 0;
+    frame_len_ = 0;
+    frame_base_ = 0;
+}
+
+void SpeeduinoParser::writeRequest_(const uint8_t *payload, uint8_t len) {
+    if (!framed_requests_) {
+        serial_->write(payload, len);
+        return;
+    }
+    // New protocol envelope: length BE16, payload, CRC32 BE
+    uint32_t crc = Crc32::compute(payload, len);
+    uint8_t head[2] = { 0, len };
+    uint8_t tail[4] = {
+        (uint8_t)(crc >> 24), (uint8_t)(crc >> 16), (uint8_t)(crc >> 8), (uint8_t)crc
+    };
+    serial_->write(head, sizeof(head));
+    serial_->write(payload, len);
+    serial_->write(tail, sizeof(tail));
+}
+
+bool SpeeduinoParser::sendRequest_(uint32_t now) {
+    if (request_cmd_ != SELECTIVE_READ_CMD) {
+        // Full block: every channel and group comes along
+        writeRequest_(&request_cmd_, 1);
+        response_len_ = PRIMARY_RESPONSE_SIZE;
+        response_base_ = 0;
+        response_mask_ = ECUData::CORE_CHANNELS | subscribed_;
+        response_groups_ = 0xFF;
+        return true;
+    }
+
+    // Multi-rate schedule: drop groups that are not due yet. Subscribed
+    // extended channels outside any group ride along with every request.
+    ECUData::ChannelMask wanted = requested_channels_ | subscribed_;
+    ECUData::ChannelMask due = wanted;
+    uint8_t groups = 0;
+    for (uint8_t g = 0; g < MAX_POLL_GROUPS; ++g) {
+        const PollGroup &pg = poll_groups_[g];
+        if (!(pg.channels & wanted)) continue;
+        if (pg.period_ms && (now - pg.last_ms) < pg.period_ms) {
+            due &= ~pg.channels;
+        } else {
+            groups |= (uint8_t)(1 << g);
+        }
+    }
+    if (!due) return false;  // only slow groups requested and none due
+
+    // Fetch only the byte span covering the due channels
+    computeWindow_(due, read_offset_, read_length_);
+    uint8_t req[7] = {
+        SELECTIVE_READ_CMD, 0x00, SELECTIVE_READ_TABLE,
+        read_offset_, 0x00,
+        read_length_, 0x00
+    };
+    writeRequest_(req, sizeof(req));
+    response_len_ = read_length_;
+    response_base_ = read_offset_;
+    response_mask_ = due;
+    response_groups_ = groups;
+    return true;
+}
+
+void SpeeduinoParser::computeWindow_(ECUData::ChannelMask channels, uint8_t &offset, uint8_t &length) const {
+    uint8_t lo = 0xFF;
+    uint8_t hi = 0;
+    for (uint8_t i = 0; i < (uint8_t)ECUData::Channel::COUNT; ++i) {
+        if (!(channels & ((ECUData::ChannelMask)1 << i))) continue;
+        const rt::FieldSpan &f = RealtimeLayout::SPANS.v[i];
+        if (f.width == 0) continue;  // compiled out
+        if (f.offset < lo) lo = f.offset;
+        if (f.offset + f.width > hi) hi = (uint8_t)(f.offset + f.width);
+    }
+    if (hi <= lo) {
+        // Nothing known requested: fall back to the full block
+        lo = 0;
+        hi = PRIMARY_RESPONSE_SIZE;
+    }
+    offset = lo;
+    length = (uint8_t)(hi - lo);
+}
+
+void SpeeduinoParser::setRequestedChannels(ECUData::ChannelMask channels) {
+    requested_channels_ = channels ? channels : ECUData::CORE_CHANNELS;
+    // Window of a slot where every group is due (reported at boot)
+    computeWindow_(requested_channels_, read_offset_, read_length_);
+}
+
+void SpeeduinoParser::configurePollGroup(uint8_t group, ECUData::ChannelMask channels, uint16_t period_ms) {
+    if (group >= MAX_POLL_GROUPS) return;
+    poll_groups_[group].channels = channels;
+    poll_groups_[group].period_ms = period_ms;
+    poll_groups_[group].last_ms = 0;
+}
+
+void SpeeduinoParser::setCsvSchema(const CsvSchema &schema, bool persist) {
+    csv_schema_ = schema;
+    applyCsvSchema_();
+    if (persist) ConfigStore::save(ConfigStore::Slot::CSV_SCHEMA, csv_schema_);
+}
+
+void SpeeduinoParser::setDefaultCsvSchema_() {
+    memset(csv_schema_.columns, CsvSchema::UNUSED, sizeof(csv_schema_.columns));
+    csv_schema_.columns[0] = (uint8_t)ECUData::Channel::RPM;
+    csv_schema_.columns[1] = (uint8_t)ECUData::Channel::MAP;
+    csv_schema_.columns[2] = (uint8_t)ECUData::Channel::TPS;
+    csv_schema_.columns[3] = (uint8_t)ECUData::Channel::CLT;
+    csv_schema_.columns[4] = (uint8_t)ECUData::Channel::IAT;
+    csv_schema_.columns[5] = (uint8_t)ECUData::Channel::AFR;
+    csv_schema_.columns[6] = (uint8_t)ECUData::Channel::BATTERY;
+    applyCsvSchema_();
+}
+
+// Derive the decoder bounds from the schema (and drop ids we do not know)
+void SpeeduinoParser::applyCsvSchema_() {
+    csv_last_column_ = 0;
+    for (uint8_t col = 0; col < CsvSchema::MAX_COLUMNS; ++col) {
+        uint8_t &ch = csv_schema_.columns[col];
+        if (ch >= (uint8_t)ECUData::Channel::COUNT) ch = CsvSchema::UNUSED;
+        if (ch != CsvSchema::UNUSED) csv_last_column_ = col;
+    }
+    // Same bar as the fixed layout: at least 5 fields unless the schema is shorter
+    csv_min_columns_ = csv_last_column_ + 1 < 5 ? csv_last_column_ + 1 : 5;
 }
 
 void SpeeduinoParser::resetLineBuffer_() {
@@ -257,132 +877,200 @@ void SpeeduinoParser::resetLineBuffer_() {
     if (LINE_BUFFER_SIZE > 0) line_buffer_[0] = '\0';
 }
 
-// Try parse Secondary Serial Generic Fixed CSV line
-// Assumption: Fixed-order CSV fields, typical order containing RPM, MAP, TPS, CLT, IAT, AFR, BAT
-// This function is resilient and attempts to map plausible indices.
-bool SpeeduinoParser::extractDataFromGenericFixed_(ECUData &ecu_data, const char *line) {
-    // Tokenize by commas
-    // We'll parse up to 24 fields to be safe
-    const uint8_t MAX_FIELDS = 24;
-    const char *fields[MAX_FIELDS];
-    uint8_t count = 0;
-    const char *p = line;
-    fields[count++] = p;
-    while (*p && count < MAX_FIELDS) {
-        if (*p == ',') {
-            fields[count++] = p + 1;
+// ---- key=value dispatch ---------------------------------------------------
+// Supported keys are hashed at compile time; the hash of an incoming key is
+// accumulated while it is scanned (uppercase, alphanumerics only) and one
+// table lookup yields the candidate key, confirmed by a single compare.
+namespace {
+
+typedef ECUData::Channel Ch;
+
+struct KvKey {
+    char name[10];
+    Ch channel;
+    bool afr_like;      // decimal AFR ("14.7") -> 10x
+};
+
+constexpr KvKey KV_KEYS[] PROGMEM = {
+    { "RPM", Ch::RPM, false },          { "MAP", Ch::MAP, false },
+    { "TPS", Ch::TPS, false },          { "CLT", Ch::CLT, false },
+    { "IAT", Ch::IAT, false },          { "AFR", Ch::AFR, false },
+    { "BAT", Ch::BATTERY, false },      { "VBAT", Ch::BATTERY, false },
+    { "BATTERY", Ch::BATTERY, false },
+    { "ADV", Ch::ADVANCE, false },      { "VE", Ch::VE, false },
+    { "AFRTGT", Ch::AFR_TARGET, true }, { "PW", Ch::PW1, false },
+    { "PW1", Ch::PW1, false },          { "TAE", Ch::TAE, false },
+    { "CORR", Ch::CORRECTIONS, false }, { "EGO", Ch::EGO, false },
+    { "BARO", Ch::BARO, false },        { "BOOSTTGT", Ch::BOOST_TARGET, false },
+    { "BOOSTDUTY", Ch::BOOST_DUTY, false }, { "FLEX", Ch::FLEX, false },
+    { "RPMDOT", Ch::RPM_DOT, false },   { "AFR2", Ch::AFR2, true },
+    { "TPSDOT", Ch::TPS_DOT, false },   { "VSS", Ch::VSS, false },
+    { "GEAR", Ch::GEAR, false },
+};
+constexpr uint8_t KV_KEY_COUNT = sizeof(KV_KEYS) / sizeof(KV_KEYS[0]);
+constexpr uint8_t KV_SLOTS = 64;    // power of two, > KV_KEY_COUNT
+constexpr uint8_t KV_NONE = 0xFF;
+static_assert(KV_KEY_COUNT < KV_SLOTS, "grow KV_SLOTS");
+
+constexpr uint16_t kvStep(uint16_t h, char c) { return (uint16_t)((uint16_t)(h * 33) ^ (uint8_t)c); }
+constexpr uint8_t kvSlot(uint16_t h) { return (uint8_t)((h ^ (h >> 7)) & (KV_SLOTS - 1)); }
+
+constexpr uint16_t kvHash(const char *s, uint16_t seed) {
+    uint16_t h = seed;
+    while (*s) h = kvStep(h, *s++);
+    return h;
+}
+
+// First seed that maps every supported key to its own slot
+constexpr uint16_t kvFindSeed() {
+    for (uint16_t seed = 1; seed < 1024; ++seed) {
+        bool used[KV_SLOTS] = {};
+        bool ok = true;
+        for (uint8_t k = 0; k < KV_KEY_COUNT && ok; ++k) {
+            uint8_t slot = kvSlot(kvHash(KV_KEYS[k].name, seed));
+            if (used[slot]) ok = false;
+            used[slot] = true;
         }
-        p++;
-    }
-    if (count < 5) {
-        // Too few fields to be generic fixed
-        return false;
+        if (ok) return seed;
     }
+    return 0;
+}
 
-    auto toInt = [](const char *s) -> int32_t {
-        // Parse int safely
-        bool neg = false;
-        int32_t val = 0;
-        while (*s == ' ' || *s == '\t') s++;
-        if (*s == '-') { neg = true; s++; }
-        while (*s >= '0' && *s <= '9') { val = val * 10 + (*s - '0'); s++; }
-        return neg ? -val : val;
-    };
+constexpr uint16_t KV_SEED = kvFindSeed();
+static_assert(KV_SEED != 0, "no perfect hash for KV_KEYS; grow KV_SLOTS");
 
-    auto toFloat = [](const char *s) -> float {
-        // Simple atof without locale
-        while (*s == ' ' || *s == '\t') s++;
-        bool neg = false;
-        if (*s == '-') { neg = true; s++; }
-        int32_t ip = 0; int32_t fp = 0; int32_t div = 1;
-        while (*s >= '0' && *s <= '9') { ip = ip * 10 + (*s - '0'); s++; }
-        if (*s == '.') { s++; while (*s >= '0' && *s <= '9') { fp = fp * 10 + (*s - '0'); div *= 10; s++; } }
-        float v = (float)ip + (fp ? (float)fp / (float)div : 0.0f);
-        return neg ? -v : v;
-    };
+struct KvSlots {
+    uint8_t v[KV_SLOTS];
+    constexpr KvSlots() : v() {
+        for (uint8_t i = 0; i < KV_SLOTS; ++i) v[i] = KV_NONE;
+        for (uint8_t k = 0; k < KV_KEY_COUNT; ++k) v[kvSlot(kvHash(KV_KEYS[k].name, KV_SEED))] = k;
+    }
+};
+const KvSlots KV_SLOT_TABLE PROGMEM = KvSlots();
 
-    // Heuristic index mapping: try common order
-    // Default indices (adjust if out-of-range):
-    int8_t idx_rpm = 0;
-    int8_t idx_map = 1;
-    int8_t idx_tps = 2;
-    int8_t idx_clt = 3;
-    int8_t idx_iat = 4;
-    int8_t idx_afr = 5;
-    int8_t idx_bat = 6;
-
-    // Extract raw values with bounds checking
-    auto getField = [&](int8_t idx) -> const char* {
-        return (idx >= 0 && idx < (int8_t)count) ? fields[idx] : nullptr;
-    };
+inline char kvNormalize(char c) {
+    if (c >= 'a' && c <= 'z') return (char)(c - 32);
+    if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return c;
+    return 0;   // ignored
+}
 
-    const char *s_rpm = getField(idx_rpm);
-    const char *s_map = getField(idx_map);
-    const char *s_tps = getField(idx_tps);
-    const char *s_clt = getField(idx_clt);
-    const char *s_iat = getField(idx_iat);
-    const char *s_afr = getField(idx_afr);
-    const char *s_bat = getField(idx_bat);
+// Key index for the normalized span [s, e) with precomputed hash, or KV_NONE
+uint8_t kvLookup(const char *s, const char *e, uint16_t h) {
+    uint8_t k = pgm_read_byte(&KV_SLOT_TABLE.v[kvSlot(h)]);
+    if (k == KV_NONE) return KV_NONE;
+    const char *name = KV_KEYS[k].name;
+    uint8_t i = 0;
+    for (; s < e; ++s) {
+        char c = kvNormalize(*s);
+        if (!c) continue;
+        if (i >= sizeof(KV_KEYS[0].name) || c != (char)pgm_read_byte(&name[i])) return KV_NONE;
+        ++i;
+    }
+    return (i < sizeof(KV_KEYS[0].name) && pgm_read_byte(&name[i]) == 0) ? k : KV_NONE;
+}
 
-    // Minimal requirement: at least one core field present
-    if (!s_rpm && !s_map && !s_tps && !s_clt && !s_iat && !s_afr && !s_bat) {
-        return false;
+// Same lookup for a name not hashed during the scan (CSV header columns)
+uint8_t kvMatch(const char *s, const char *e) {
+    uint16_t h = KV_SEED;
+    for (const char *c = s; c < e; ++c) {
+        char n = kvNormalize(*c);
+        if (n) h = kvStep(h, n);
     }
+    return kvLookup(s, e, h);
+}
 
-    // Compute locals first; assign later only if present
-    bool has_rpm = false, has_map = false, has_tps = false, has_clt = false, has_iat = false;
-    uint16_t rpm_v = 0, map_v = 0, tps_v = 0; int16_t clt_v = 0, iat_v = 0;
-    if (s_rpm) { rpm_v = (uint16_t)toInt(s_rpm); has_rpm = true; }
-    if (s_map) { map_v = (uint16_t)toInt(s_map); has_map = true; }
-    if (s_tps) { tps_v = (uint16_t)toInt(s_tps); has_tps = true; }
-    if (s_clt) { clt_v = (int16_t)toInt(s_clt); has_clt = true; }
-    if (s_iat) { iat_v = (int16_t)toInt(s_iat); has_iat = true; }
-
-    // AFR can be float (e.g., 14.7) or 100x (e.g., 1470)
-    uint16_t afr100 = 0;
-    if (s_afr) {
-        float afr_f = toFloat(s_afr);
-        if (afr_f > 0.0f && afr_f < 50.0f) {
-            afr100 = (uint16_t)(afr_f * 100.0f + 0.5f);
-        } else {
-            // Treat as 100x if realistic range
-            int32_t ai = toInt(s_afr);
-            afr100 = (uint16_t)ai;
+}  // namespace
+
+// A CSV line starting with a letter is a header ("RPM,MAP,CLT,...").
+// Known column names (same names as key=value keys) become the new schema,
+// which is persisted so the header is only needed once.
+bool SpeeduinoParser::learnCsvHeader_(const char *line) {
+    while (*line == ' ' || *line == '\t') line++;
+    char c = *line;
+    if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))) return false;
+
+    CsvSchema schema;
+    memset(schema.columns, CsvSchema::UNUSED, sizeof(schema.columns));
+    bool any = false;
+    const char *p = line;
+    for (uint8_t col = 0; col < CsvSchema::MAX_COLUMNS; ++col) {
+        const char *start = p;
+        while (*p && *p != ',') p++;
+        uint8_t k = kvMatch(start, p);
+        if (k != KV_NONE) {
+            schema.columns[col] = pgm_read_byte(&KV_KEYS[k].channel);
+            any = true;
         }
+        if (!*p) break;
+        p++;
+    }
+    if (!any) return true;  // header we cannot use: keep the current schema
+    if (memcmp(&schema, &csv_schema_, sizeof(schema)) != 0) {
+        setCsvSchema(schema, true);
+        Serial.println(F("[Parser] CSV schema learned from header"));
     }
+    return true;
+}
 
-    // Battery can be float volts or integer tenths; store as mV
-    uint16_t bat_mv = 0;
-    if (s_bat) {
-        float bat_f = toFloat(s_bat);
-        if (bat_f > 0.0f && bat_f < 30.0f) {
-            bat_mv = (uint16_t)(bat_f * 1000.0f + 0.5f);
-        } else {
-            int32_t bi = toInt(s_bat);
-            // Heuristic: if 0..160 likely tenths of volts
-            if (bi >= 0 && bi <= 160) bat_mv = (uint16_t)(bi * 100);
-            else if (bi < 30000) bat_mv = (uint16_t)bi; // already millivolts
+// Generic Fixed CSV line, columns mapped through csv_schema_ (EEPROM or
+// header line; default RPM, MAP, TPS, CLT, IAT, AFR, BAT).
+// Only mapped columns are scanned; the rest are skipped to the next comma,
+// and nothing past the last mapped column is looked at.
+bool SpeeduinoParser::extractDataFromGenericFixed_(ECUData &ecu_data, const char *line) {
+    constexpr uint8_t CORE = (uint8_t)ECUData::Channel::BATTERY + 1;
+    fixp::Decimal core[CORE];
+    int32_t ext[(uint8_t)ECUData::Channel::COUNT - CORE];
+    ECUData::ChannelMask got = 0;
+    const char *p = line;
+    uint8_t col = 0;
+    for (;;) {
+        uint8_t ch = csv_schema_.columns[col];
+        if (ch != CsvSchema::UNUSED) {
+            fixp::Decimal d;
+            p = fixp::scan(p, d);
+            if (ch < CORE) {
+                core[ch] = d;
+            } else {
+                bool afr_like = ch == (uint8_t)ECUData::Channel::AFR_TARGET || ch == (uint8_t)ECUData::Channel::AFR2;
+                ext[ch - CORE] = (afr_like && fixp::inOpenRange(d, 50)) ? fixp::scaled<10>(d) : d.whole;
+            }
+            got |= (ECUData::ChannelMask)1 << ch;
         }
+        if (col == csv_last_column_) break;
+        while (*p && *p != ',') p++;
+        if (!*p) break;
+        p++;
+        col++;
     }
+    if (col + 1 < csv_min_columns_) {
+        // Too few fields to be generic fixed
+        return false;
+    }
+
+    auto has = [&](ECUData::Channel c) { return (got & ECUData::channelBit(c)) != 0; };
+    auto whole = [&](ECUData::Channel c) { return core[(uint8_t)c].whole; };
+    uint16_t afr100 = has(ECUData::Channel::AFR) ? afr100FromDecimal_(core[(uint8_t)ECUData::Channel::AFR]) : 0;
+    uint16_t bat_mv = has(ECUData::Channel::BATTERY) ? batteryMvFromDecimal_(core[(uint8_t)ECUData::Channel::BATTERY]) : 0;
 
     // Plausibility checks
-    if (has_rpm && rpm_v > 18000) return false;
-    if (has_map && map_v > 255) return false;
-    if (has_tps && tps_v > 100) return false;
-    if (afr100 && (afr100 < 800 || afr100 > 2500)) {
-        // If outside reasonable AFR range, keep as unknown
-        afr100 = 0;
-    }
-    if (bat_mv && bat_mv > 20000) bat_mv = 0; // unrealistic
+    if (has(ECUData::Channel::RPM) && (uint16_t)whole(ECUData::Channel::RPM) > 18000) return false;
+    if (has(ECUData::Channel::MAP) && (uint16_t)whole(ECUData::Channel::MAP) > 255) return false;
+    if (has(ECUData::Channel::TPS) && (uint16_t)whole(ECUData::Channel::TPS) > 100) return false;
 
     // Assign to ecu_data
-    if (has_rpm) ecu_data.rpm = rpm_v;
-    if (has_map) ecu_data.map = map_v;
-    if (has_tps) ecu_data.tps = tps_v;
-    if (has_clt) ecu_data.clt = clt_v;
-    if (has_iat) ecu_data.iat = iat_v;
-    if (afr100) ecu_data.afr = afr100; // keep previous if 0
-    if (bat_mv) ecu_data.battery = bat_mv;
+    if (has(Ch::RPM)) ecu_data.store(Ch::RPM, &ECUData::rpm, (uint16_t)whole(Ch::RPM));
+    if (has(Ch::MAP)) ecu_data.store(Ch::MAP, &ECUData::map, (uint16_t)whole(Ch::MAP));
+    if (has(Ch::TPS)) ecu_data.store(Ch::TPS, &ECUData::tps, (uint16_t)whole(Ch::TPS));
+    if (has(Ch::CLT)) ecu_data.store(Ch::CLT, &ECUData::clt, (int16_t)whole(Ch::CLT));
+    if (has(Ch::IAT)) ecu_data.store(Ch::IAT, &ECUData::iat, (int16_t)whole(Ch::IAT));
+    if (afr100) ecu_data.store(Ch::AFR, &ECUData::afr, afr100); // keep previous if 0
+    if (bat_mv) ecu_data.store(Ch::BATTERY, &ECUData::battery, bat_mv);
+    ECUData::ChannelMask ext_got = got & ecu_data.subscriptions() & ECUData::EXTENDED_CHANNELS;
+    for (uint8_t ch = CORE; ext_got; ++ch) {
+        if (!(ext_got & ((ECUData::ChannelMask)1 << ch))) continue;
+        ext_got &= ~((ECUData::ChannelMask)1 << ch);
+        setExtendedChannel_(ecu_data, (ECUData::Channel)ch, ext[ch - CORE]);
+    }
 
     ecu_data.lastUpdateMillis = millis();
     ecu_data.isDataValid = true;
@@ -390,24 +1078,60 @@ bool SpeeduinoParser::extractDataFromGenericFixed_(ECUData &ecu_data, const char
 }
 
 void SpeeduinoParser::debugPrint() const {
-    Serial.println("\n=== SpeeduinoParser Stats ===");
-    Serial.print("Frames Received: "); Serial.println(frames_received_);
-    Serial.print("Frames Errored: "); Serial.println(frames_errored_);
-    Serial.print("Sync Losses: "); Serial.println(sync_losses_);
-    Serial.print("Consecutive Errors: "); Serial.println(consecutive_errors_);
-    Serial.print("Raw Bytes: "); Serial.println(raw_bytes_);
-    Serial.print("Millis since last RX: "); Serial.println(last_rx_ms_ ? (millis() - last_rx_ms_) : 0);
-    Serial.print("Request Mode: "); Serial.println(request_mode_ ? "ON" : "OFF");
+    Serial.println(F("\n=== SpeeduinoParser Stats ==="));
+    Serial.print(F("Frames Received: ")); Serial.println(frames_received_);
+    Serial.print(F("Frames Errored: ")); Serial.println(frames_errored_);
+    Serial.print(F("Sync Losses: ")); Serial.println(sync_losses_);
+    Serial.print(F("Consecutive Errors: ")); Serial.println(consecutive_errors_);
+    Serial.print(F("Raw Bytes: ")); Serial.println(raw_bytes_);
+    Serial.print(F("RX Overflows: ")); Serial.println(rx_.overflows());
+    Serial.print(F("Resyncs: ")); Serial.println(resyncs_);
+    Serial.print(F("Rejects (plaus/parse/tmo/hdr/len/crc/rc):"));
+    for (uint8_t i = 0; i < (uint8_t)RejectReason::COUNT; ++i) {
+        Serial.print(' '); Serial.print(reject_counts_[i]);
+    }
+    Serial.println();
+    Serial.print(F("Millis since last RX: ")); Serial.println(last_rx_ms_ ? (millis() - last_rx_ms_) : 0);
+    Serial.print(F("Protocol: ")); Serial.println(getProtocolString());
+    Serial.print(F("Baud: ")); Serial.print(baud_rate_);
+    Serial.println(baud_scanning_ ? F(" (scanning)") : (baud_auto_ ? F(" (auto)") : F("")));
+    Serial.print(F("Request Mode: ")); Serial.println(request_mode_ ? F("ON") : F("OFF"));
     if (request_mode_) {
-        Serial.print("Request Cmd: 0x"); Serial.println(request_cmd_, HEX);
-        Serial.print("Request Period(ms): "); Serial.println(request_period_ms_);
-    }
-    // Print last up to 32 bytes in hex (LSB = most recent)
-    Serial.print("Last Bytes (newest last): ");
-    uint8_t count = LAST_BYTES_CAP < 32 ? LAST_BYTES_CAP : 32;
-    uint8_t start = (last_bytes_idx_ + LAST_BYTES_CAP - count) % LAST_BYTES_CAP;
-    for (uint8_t i = 0; i < count; ++i) {
-        uint8_t b = last_bytes_[(start + i) % LAST_BYTES_CAP];
+        Serial.print(F("Request Cmd: 0x")); Serial.print(request_cmd_, HEX);
+        Serial.println(framed_requests_ ? F(" (framed/CRC32)") : F(""));
+        Serial.print(F("Request Period(ms): ")); Serial.println(request_period_ms_);
+        Serial.print(F("Turnaround(us): ")); Serial.println(rtt_ewma_us_);
+        Serial.print(F("Response Timeout(ms): ")); Serial.println(responseTimeoutMs_());
+        Serial.print(F("Timeouts/Retries: ")); Serial.print(request_timeouts_);
+        Serial.print(F("/")); Serial.println(request_retries_);
+        if (request_cmd_ == SELECTIVE_READ_CMD) {
+            Serial.print(F("Read Window: ")); Serial.print(read_offset_);
+            Serial.print(F(" +")); Serial.println(read_length_);
+            for (uint8_t g = 0; g < MAX_POLL_GROUPS; ++g) {
+                if (!poll_groups_[g].channels) continue;
+                Serial.print(F("Poll Group ")); Serial.print(g);
+                Serial.print(F(": mask=0x")); Serial.print(poll_groups_[g].channels, HEX);
+                Serial.print(F(" period=")); Serial.print(poll_groups_[g].period_ms);
+                Serial.print(F("ms age=")); Serial.println(millis() - poll_groups_[g].last_ms);
+            }
+        }
+    }
+    // RX link utilisation since the previous dump (10 bits per byte on the wire)
+    uint32_t now = millis();
+    if (now != util_last_ms_ && baud_rate_) {
+        uint32_t bits = (raw_bytes_ - util_last_bytes_) * 10UL;
+        uint32_t capacity = (baud_rate_ / 100UL) * (now - util_last_ms_) / 1000UL;  // window bits / 100
+        Serial.print(F("RX Utilisation: "));
+        Serial.print(capacity ? bits / capacity : 0);
+        Serial.println(F("%"));
+        util_last_ms_ = now;
+        util_last_bytes_ = raw_bytes_;
+    }
+    // Print last up to 32 bytes in hex, straight from the RX ring history
+    Serial.print(F("Last Bytes (newest last): "));
+    uint8_t count = raw_bytes_ < 32 ? (uint8_t)raw_bytes_ : 32;
+    for (uint8_t i = count; i > 0; --i) {
+        uint8_t b = rx_.recent(i - 1);
         if (b < 16) Serial.print('0');
         Serial.print(b, HEX);
         Serial.print(' ');
@@ -421,82 +1145,100 @@ void SpeeduinoParser::configureRequest(uint8_t cmd, uint32_t period_ms) {
     request_period_ms_ = period_ms ? period_ms : 50;
 }
 
+// AFR as decimal (14.7) or already 100x (1470); 0 when implausible
+uint16_t SpeeduinoParser::afr100FromDecimal_(const fixp::Decimal &d) {
+    int32_t afr100 = fixp::inOpenRange(d, 50) ? fixp::scaled<100>(d) : d.whole;
+    return (afr100 >= 800 && afr100 <= 2500) ? (uint16_t)afr100 : 0;
+}
+
+// Battery as volts (12.6), tenths (126) or millivolts (12600); 0 when implausible
+uint16_t SpeeduinoParser::batteryMvFromDecimal_(const fixp::Decimal &d) {
+    if (fixp::inOpenRange(d, 30)) return (uint16_t)fixp::scaled<1000>(d);
+    int32_t bi = d.whole;
+    if (bi >= 0 && bi <= 160) return (uint16_t)(bi * 100);
+    if (bi > 160 && bi <= 20000) return (uint16_t)bi;
+    return 0;
+}
+
+
+// Store an extended channel value (already in ECUData units)
+void SpeeduinoParser::setExtendedChannel_(ECUData &ecu_data, ECUData::Channel ch, int32_t v) {
+    switch (ch) {
+        case Ch::ADVANCE:      ecu_data.store(ch, &ECUData::advance, (int8_t)v); break;
+        case Ch::VE:           ecu_data.store(ch, &ECUData::ve, (uint8_t)v); break;
+        case Ch::AFR_TARGET:   ecu_data.store(ch, &ECUData::afrTarget, (uint8_t)v); break;
+        case Ch::PW1:          ecu_data.store(ch, &ECUData::pw1, (uint16_t)v); break;
+        case Ch::TAE:          ecu_data.store(ch, &ECUData::tae, (uint8_t)v); break;
+        case Ch::CORRECTIONS:  ecu_data.store(ch, &ECUData::corrections, (uint8_t)v); break;
+        case Ch::EGO:          ecu_data.store(ch, &ECUData::ego, (uint8_t)v); break;
+        case Ch::BARO:         ecu_data.store(ch, &ECUData::baro, (uint8_t)v); break;
+        case Ch::BOOST_TARGET: ecu_data.store(ch, &ECUData::boostTarget, (uint16_t)v); break;
+        case Ch::BOOST_DUTY:   ecu_data.store(ch, &ECUData::boostDuty, (uint8_t)v); break;
+        case Ch::FLEX:         ecu_data.store(ch, &ECUData::flex, (uint8_t)v); break;
+        case Ch::RPM_DOT:      ecu_data.store(ch, &ECUData::rpmDot, (int16_t)v); break;
+        case Ch::AFR2:         ecu_data.store(ch, &ECUData::afr2, (uint8_t)v); break;
+        case Ch::TPS_DOT:      ecu_data.store(ch, &ECUData::tpsDot, (uint16_t)v); break;
+        case Ch::VSS:          ecu_data.store(ch, &ECUData::vss, (uint16_t)v); break;
+        case Ch::GEAR:         ecu_data.store(ch, &ECUData::gear, (uint8_t)v); break;
+        default: break;
+    }
+}
+
 // Parse ASCII line with key=value pairs, tokens separated by comma or space
 bool SpeeduinoParser::extractDataFromKeyValue_(ECUData &ecu_data, const char *line) {
-    auto toInt = [](const char *s) -> int32_t {
-        bool neg = false; int32_t v = 0;
-        while (*s == ' ' || *s == '\t') s++;
-        if (*s == '-') { neg = true; s++; }
-        while (*s >= '0' && *s <= '9') { v = v * 10 + (*s - '0'); s++; }
-        return neg ? -v : v;
-    };
-    auto toFloat = [](const char *s) -> float {
-        while (*s == ' ' || *s == '\t') s++;
-        bool neg = false; if (*s == '-') { neg = true; s++; }
-        int32_t ip = 0, fp = 0, div = 1;
-        while (*s >= '0' && *s <= '9') { ip = ip * 10 + (*s - '0'); s++; }
-        if (*s == '.') { s++; while (*s >= '0' && *s <= '9') { fp = fp * 10 + (*s - '0'); div *= 10; s++; } }
-        float v = (float)ip + (fp ? (float)fp / (float)div : 0.0f);
-        return neg ? -v : v;
-    };
-
     // Iterate tokens
     const char *p = line;
     bool any = false;
     while (*p) {
         // Skip separators
         while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        // Key: hash accumulated on the fly, no copy
         const char *key_start = p;
-        while (*p && *p != '=' && *p != ',' && *p != '\n' && *p != '\r') p++;
+        uint16_t h = KV_SEED;
+        while (*p && *p != '=' && *p != ',' && *p != '\n' && *p != '\r') {
+            char c = kvNormalize(*p++);
+            if (c) h = kvStep(h, c);
+        }
         if (*p != '=') { while (*p && *p != ',' && *p != '\n' && *p != '\r') p++; continue; }
         const char *key_end = p; // points at '='
         p++; // move past '='
-        const char *val_start = p;
+        // Value scanned in place, then skip whatever trails it
+        fixp::Decimal val;
+        p = fixp::scan(p, val);
         while (*p && *p != ',' && *p != '\n' && *p != '\r') p++;
-        const char *val_end = p;
-
-        // Normalize key to uppercase short id
-        char key[12]; uint8_t ki = 0;
-        const char *ks = key_start;
-        while (ks < key_end && ki < sizeof(key) - 1) {
-            char c = *ks++;
-            if (c >= 'a' && c <= 'z') c = (char)(c - 32);
-            if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) key[ki++] = c;
-        }
-        key[ki] = '\0';
-
-        // Extract value string
-        char val[24]; uint8_t vi = 0;
-        const char *vs = val_start;
-        while (vs < val_end && vi < sizeof(val) - 1) { val[vi++] = *vs++; }
-        val[vi] = '\0';
-
-        // Map known keys
-        if (strcmp(key, "RPM") == 0) { ecu_data.rpm = (uint16_t)toInt(val); any = true; }
-        else if (strcmp(key, "MAP") == 0) { ecu_data.map = (uint16_t)toInt(val); any = true; }
-        else if (strcmp(key, "TPS") == 0) { ecu_data.tps = (uint16_t)toInt(val); any = true; }
-        else if (strcmp(key, "CLT") == 0) { ecu_data.clt = (int16_t)toInt(val); any = true; }
-        else if (strcmp(key, "IAT") == 0) { ecu_data.iat = (int16_t)toInt(val); any = true; }
-        else if (strcmp(key, "AFR") == 0) {
-            float f = toFloat(val);
-            if (f > 0.0f && f < 50.0f) ecu_data.afr = (uint16_t)(f * 100.0f + 0.5f);
-            else {
-                int32_t ai = toInt(val);
-                if (ai >= 800 && ai <= 2500) ecu_data.afr = (uint16_t)ai;
+        // Advance past separator if present
+        if (*p == ',') p++;
+
+        uint8_t k = kvLookup(key_start, key_end, h);
+        if (k == KV_NONE) continue;
+        Ch ch = (Ch)pgm_read_byte(&KV_KEYS[k].channel);
+        switch (ch) {
+            case Ch::RPM: ecu_data.store(ch, &ECUData::rpm, (uint16_t)val.whole); break;
+            case Ch::MAP: ecu_data.store(ch, &ECUData::map, (uint16_t)val.whole); break;
+            case Ch::TPS: ecu_data.store(ch, &ECUData::tps, (uint16_t)val.whole); break;
+            case Ch::CLT: ecu_data.store(ch, &ECUData::clt, (int16_t)val.whole); break;
+            case Ch::IAT: ecu_data.store(ch, &ECUData::iat, (int16_t)val.whole); break;
+            case Ch::AFR: {
+                uint16_t afr100 = afr100FromDecimal_(val);
+                if (afr100) ecu_data.store(ch, &ECUData::afr, afr100);
+                break;
             }
-            any = true;
-        }
-        else if (strcmp(key, "BAT") == 0 || strcmp(key, "VBAT") == 0 || strcmp(key, "BATTERY") == 0) {
-            float f = toFloat(val);
-            if (f > 0.0f && f < 30.0f) ecu_data.battery = (uint16_t)(f * 1000.0f + 0.5f);
-            else {
-                int32_t bi = toInt(val);
-                if (bi >= 0 && bi <= 160) ecu_data.battery = (uint16_t)(bi * 100);
+            case Ch::BATTERY: {
+                uint16_t bat_mv = batteryMvFromDecimal_(val);
+                if (bat_mv) ecu_data.store(ch, &ECUData::battery, bat_mv);
+                break;
             }
-            any = true;
+            default:
+                // Extended channels: only kept up to date while subscribed
+                if (!ecu_data.isSubscribed(ch)) break;
+                if (pgm_read_byte(&KV_KEYS[k].afr_like) && fixp::inOpenRange(val, 50)) {
+                    setExtendedChannel_(ecu_data, ch, fixp::scaled<10>(val));
+                } else {
+                    setExtendedChannel_(ecu_data, ch, val.whole);
+                }
+                break;
         }
-        // Advance past separator if present
-        if (*p == ',') p++;
+        any = true;
     }
 
     if (any) {
@@ -1,11 +1,27 @@
 #include "SyncManager.h"
 
+// Trend limits at or below the noise floor would alarm on a single LSB step
+static_assert(SyncManager::Thresholds{}.clt_rise_max > SyncManager::CLT_TREND_NOISE,
+              "clt_rise_max must stay above CLT_TREND_NOISE");
+static_assert(SyncManager::Thresholds{}.battery_fall_max > SyncManager::BATTERY_TREND_NOISE,
+              "battery_fall_max must stay above BATTERY_TREND_NOISE");
+
 SyncManager::SyncManager()
     : current_state_(SyncState::NO_DATA),
       previous_state_(SyncState::NORMAL),
       state_changed_(false),
       state_enter_time_(0),
-      previous_sync_counter_(0) {
+      previous_sync_counter_(0),
+      thresholds_changed_(true),
+      link_(nullptr),
+      afr_min_table_(nullptr),
+      afr_max_table_(nullptr),
+      rpm_(0),
+      map_(0),
+      alarms_pending_(false),
+      trend_sample_ms_(0) {
+    memset(alarms_, 0, sizeof(alarms_));
+    clearTrends_();
     
     // Default thresholds (tuned untuk automotive use)
     thresholds_.rpm_max = 8000;
@@ -20,6 +36,13 @@ SyncManager::SyncManager()
 
 void SyncManager::setThresholds(const Thresholds &thresholds) {
     thresholds_ = thresholds;
+    thresholds_changed_ = true;
+}
+
+void SyncManager::setAfrTables(const AfrTable *afr_min, const AfrTable *afr_max) {
+    afr_min_table_ = afr_min;
+    afr_max_table_ = afr_max;
+    thresholds_changed_ = true;
 }
 
 const char* SyncManager::getStateString() const {
@@ -37,78 +60,261 @@ const char* SyncManager::getStateString() const {
 void SyncManager::update(const ECUData &ecu_data) {
     state_changed_ = false;
     
-    // Check data timeout (NO_DATA state)
-    if (ecu_data.isStale(thresholds_.data_timeout_ms)) {
+    // Check data timeout (NO_DATA state); a slow but steady link gets a
+    // proportionally longer window
+    if (ecu_data.isStale(dataTimeout_())) {
         handleStateTransition_(SyncState::NO_DATA);
+        clearTrends_();  // a gap would bend the fit
         return;
     }
     
-    // Check sync counter change
-    if (ecu_data.syncLossCounter > previous_sync_counter_) {
+    // Check sync counter change, or a link dropping too many frames
+    bool counter_loss = ecu_data.syncLossCounter > previous_sync_counter_;
+    if (counter_loss || linkFlaky_()) {
         previous_sync_counter_ = ecu_data.syncLossCounter;
         handleStateTransition_(SyncState::SYNC_LOSS);
         return;
     }
     
-    // Evaluate thresholds
-    evaluateThresholds_(ecu_data);
+    // Evaluate thresholds — skipped while the monitored raw values and the
+    // thresholds are unchanged and no debounce timer runs, since the
+    // verdict would be identical
+    bool settled = current_state_ == SyncState::NORMAL ||
+                   current_state_ == SyncState::CAUTION ||
+                   current_state_ == SyncState::WARNING;
+    bool trend_sampled = sampleTrends_(ecu_data);
+    if (!settled || thresholds_changed_ || alarms_pending_ || trend_sampled ||
+        ecu_data.hasChanged(monitoredChannels())) {
+        evaluateThresholds_(ecu_data);
+        thresholds_changed_ = false;
+    }
     
     // Recovery logic: setelah SYNC_LOSS atau NO_DATA, tunggu stabil sebelum NORMAL
     if (current_state_ == SyncState::RECOVERY) {
-        uint32_t recovery_elapsed = millis() - state_enter_time_;
-        if (recovery_elapsed >= thresholds_.recovery_delay_ms) {
+        if (link_ && !link_->isHealthy()) {
+            state_enter_time_ = millis();  // link not steady yet: restart the wait
+        } else if (millis() - state_enter_time_ >= recoveryDelay_()) {
             handleStateTransition_(SyncState::NORMAL);
+            evaluateThresholds_(ecu_data);  // alarms apply right away
         }
     }
     else if (current_state_ == SyncState::SYNC_LOSS || current_state_ == SyncState::NO_DATA) {
-        // Jika data kembali valid, masuk RECOVERY terlebih dahulu
-        if (hasValidData_(ecu_data)) {
+        // Jika data kembali valid (frame baru sejak loss) dan link sudah sehat
+        // lagi (bukan sekadar di bawah batas loss), masuk RECOVERY terlebih dahulu
+        bool fresh = (int32_t)(ecu_data.lastUpdateMillis - state_enter_time_) >= 0;
+        if (hasValidData_(ecu_data) && fresh && (!link_ || link_->isHealthy())) {
             handleStateTransition_(SyncState::RECOVERY);
         }
     }
 }
 
 void SyncManager::evaluateThresholds_(const ECUData &ecu_data) {
-    int warning_count = 0;
-    int caution_count = 0;
-    
-    // CLT check
-    if (ecu_data.clt < thresholds_.clt_min || ecu_data.clt > thresholds_.clt_max) {
-        warning_count++;
-    } else if (ecu_data.clt < thresholds_.clt_min + 5 || ecu_data.clt > thresholds_.clt_max - 5) {
-        caution_count++;
-    }
-    
-    // AFR check
-    if (ecu_data.afr < thresholds_.afr_min || ecu_data.afr > thresholds_.afr_max) {
-        warning_count++;
-    } else if (ecu_data.afr < thresholds_.afr_min + 100 || ecu_data.afr > thresholds_.afr_max - 100) {
-        caution_count++;
+    uint8_t warning_count = 0;
+    uint8_t caution_count = 0;
+    uint32_t now = millis();
+    alarms_pending_ = false;
+    rpm_ = (uint16_t)ecu_data.value(ECUData::Channel::RPM);
+    map_ = (uint16_t)ecu_data.value(ECUData::Channel::MAP);
+
+    for (uint8_t i = 0; i < ALARM_COUNT; ++i) {
+        const AlarmRule &rule = ALARM_TABLE[i];
+        AlarmState &a = alarms_[i];
+        AlarmLevel raw = classify_(rule, ecu_data.value(rule.channel), (AlarmLevel)a.level);
+        AlarmLevel level = debounce_(a, raw, rule.debounce_ms, (rule.flags & ALARM_LATCH) != 0, now);
+        if (level == AlarmLevel::WARNING) warning_count++;
+        else if (level == AlarmLevel::CAUTION) caution_count++;
     }
-    
-    // Battery check
-    if (ecu_data.battery < thresholds_.battery_min) {
-        warning_count++;
-    } else if (ecu_data.battery < thresholds_.battery_min + 500) {  // 11.5V
-        caution_count++;
+
+    // Trend verdicts (classified once per trend sample), same debounce
+    TrendAlarm *trends[] = { &clt_trend_, &battery_trend_ };
+    for (TrendAlarm *t : trends) {
+        AlarmLevel level = debounce_(t->alarm, (AlarmLevel)t->raw, TREND_DEBOUNCE_MS, false, now);
+        if (level == AlarmLevel::WARNING) warning_count++;
+        else if (level == AlarmLevel::CAUTION) caution_count++;
     }
     
     // State transition based on warnings
     SyncState new_state = SyncState::NORMAL;
     
-    if (warning_count >= 2) {
-        new_state = SyncState::WARNING;
-    } else if (warning_count == 1 || caution_count >= 2) {
+    if (warning_count >= 1 || caution_count >= 2) {
         new_state = SyncState::WARNING;
     } else if (caution_count >= 1) {
         new_state = SyncState::CAUTION;
     }
     
-    if (new_state != current_state_) {
+    // Alarm levels stay current in every state, but only drive the state
+    // once the link is settled (RECOVERY decides its own exit)
+    bool settled = current_state_ == SyncState::NORMAL ||
+                   current_state_ == SyncState::CAUTION ||
+                   current_state_ == SyncState::WARNING;
+    if (settled && new_state != current_state_) {
         handleStateTransition_(new_state);
     }
 }
 
+SyncManager::AlarmLevel SyncManager::debounce_(AlarmState &a, AlarmLevel raw, uint16_t debounce_ms,
+                                               bool latch, uint32_t now) {
+    // Debounce: the raw level must hold for debounce_ms before it counts.
+    // Readings that swing on the same side of the committed level keep
+    // the timer running and move towards the smaller step
+    if ((uint8_t)raw != a.pending) {
+        bool up = (uint8_t)raw > a.level && a.pending > a.level;
+        bool down = (uint8_t)raw < a.level && a.pending < a.level;
+        if (up) {
+            if ((uint8_t)raw < a.pending) a.pending = (uint8_t)raw;
+        } else if (down) {
+            if ((uint8_t)raw > a.pending) a.pending = (uint8_t)raw;
+        } else {
+            a.pending = (uint8_t)raw;
+            a.pending_since = now;
+        }
+    }
+    if (a.pending != a.level) {
+        if (now - a.pending_since >= debounce_ms) {
+            if (a.pending == (uint8_t)AlarmLevel::WARNING && latch) a.latched = true;
+            a.level = a.pending;
+        } else {
+            alarms_pending_ = true;
+        }
+    }
+    return a.latched ? AlarmLevel::WARNING : (AlarmLevel)a.level;
+}
+
+SyncManager::AlarmLevel SyncManager::classify_(const AlarmRule &rule, int32_t value, AlarmLevel current) const {
+    int32_t lo, hi;
+    limits_(rule.channel, lo, hi);
+    // Two-sided rules on a narrow window (AFR table under boost): each
+    // caution band takes at most a quarter of the window and the hysteresis
+    // half a band, so the middle of the window stays NONE
+    int32_t band = rule.caution_band;
+    int32_t hyst = rule.hysteresis;
+    if ((rule.flags & ALARM_LOW) && (rule.flags & ALARM_HIGH)) {
+        int32_t quarter = (hi - lo) / 4;
+        if (band > quarter) band = quarter > 0 ? quarter : 0;
+        if (hyst > band / 2) hyst = band / 2;
+    }
+    // A level already reached only clears once the value is back inside by
+    // the hysteresis band, so a value sitting on a limit does not flap
+    int32_t hw = current >= AlarmLevel::WARNING ? hyst : 0;
+    int32_t hc = current >= AlarmLevel::CAUTION ? hyst : 0;
+    if (rule.flags & ALARM_HIGH) {
+        if (value > hi - hw) return AlarmLevel::WARNING;
+    }
+    if (rule.flags & ALARM_LOW) {
+        if (value < lo + hw) return AlarmLevel::WARNING;
+    }
+    if ((rule.flags & ALARM_HIGH) && value > hi - band - hc) return AlarmLevel::CAUTION;
+    if ((rule.flags & ALARM_LOW) && value < lo + band + hc) return AlarmLevel::CAUTION;
+    return AlarmLevel::NONE;
+}
+
+void SyncManager::limits_(ECUData::Channel ch, int32_t &lo, int32_t &hi) const {
+    lo = 0;
+    hi = 0;
+    switch (ch) {
+        case ECUData::Channel::RPM:     hi = thresholds_.rpm_max; break;
+        case ECUData::Channel::CLT:     lo = thresholds_.clt_min; hi = thresholds_.clt_max; break;
+        case ECUData::Channel::AFR:
+            lo = afr_min_table_ ? afr_min_table_->lookup(rpm_, map_) : thresholds_.afr_min;
+            hi = afr_max_table_ ? afr_max_table_->lookup(rpm_, map_) : thresholds_.afr_max;
+            break;
+        case ECUData::Channel::BATTERY: lo = thresholds_.battery_min; break;
+        default: break;
+    }
+}
+
+bool SyncManager::sampleTrends_(const ECUData &ecu_data) {
+    uint32_t now = millis();
+    if (!ecu_data.isDataValid || now - trend_sample_ms_ < TREND_PERIOD_MS) return false;
+    trend_sample_ms_ = now;
+
+    clt_trend_.fit.push((int16_t)ecu_data.value(ECUData::Channel::CLT));
+    battery_trend_.fit.push((int16_t)ecu_data.value(ECUData::Channel::BATTERY));
+    if (!clt_trend_.fit.full()) return true;
+
+    // CLT rising towards clt_max, battery falling towards battery_min
+    TrendAlarm &c = clt_trend_;
+    c.rate = c.fit.perMinute();
+    c.raw = (uint8_t)classifyTrend_(c, c.rate, CLT_TREND_NOISE, thresholds_.clt_rise_max,
+                                    thresholds_.clt_max);
+    TrendAlarm &b = battery_trend_;
+    b.rate = b.fit.perMinute();
+    b.raw = (uint8_t)classifyTrend_(b, -b.rate, BATTERY_TREND_NOISE, thresholds_.battery_fall_max,
+                                    thresholds_.battery_min);
+    return true;
+}
+
+SyncManager::AlarmLevel SyncManager::classifyTrend_(TrendAlarm &t, int32_t rise, int16_t noise,
+                                                    int16_t rise_max, int32_t limit) const {
+    // rise: rate towards the limit. Within the noise floor the fit only
+    // reflects an LSB step, so there is nothing to project
+    t.ttl_s = rise > noise ? t.fit.secondsTo(limit) : -1;
+    AlarmLevel current = (AlarmLevel)t.alarm.level;
+
+    // Hysteresis: a committed level holds until the projection moves 5/4
+    // of the window away or the rate falls under 3/4 of its limit
+    uint32_t ttl_max = thresholds_.time_to_limit_s;
+    if (current == AlarmLevel::WARNING) ttl_max += ttl_max / 4;
+    if (thresholds_.time_to_limit_s && t.ttl_s >= 0 && (uint32_t)t.ttl_s <= ttl_max) {
+        return AlarmLevel::WARNING;
+    }
+    int32_t rise_lim = rise_max;
+    if (current != AlarmLevel::NONE) rise_lim -= rise_lim / 4;
+    if (rise_max && rise > noise && rise > rise_lim) return AlarmLevel::CAUTION;
+    return AlarmLevel::NONE;
+}
+
+void SyncManager::clearTrends_() {
+    TrendAlarm *trends[] = { &clt_trend_, &battery_trend_ };
+    for (TrendAlarm *t : trends) {
+        t->fit.clear();
+        t->rate = 0;
+        t->ttl_s = -1;
+        t->raw = (uint8_t)AlarmLevel::NONE;
+        memset(&t->alarm, 0, sizeof(t->alarm));
+    }
+}
+
+int32_t SyncManager::getTrendPerMin(ECUData::Channel ch) const {
+    if (ch == ECUData::Channel::CLT) return clt_trend_.rate;
+    if (ch == ECUData::Channel::BATTERY) return battery_trend_.rate;
+    return 0;
+}
+
+int32_t SyncManager::getTimeToLimit(ECUData::Channel ch) const {
+    if (ch == ECUData::Channel::CLT) return clt_trend_.ttl_s;
+    if (ch == ECUData::Channel::BATTERY) return battery_trend_.ttl_s;
+    return -1;
+}
+
+SyncManager::AlarmLevel SyncManager::getAlarmLevel(ECUData::Channel ch) const {
+    for (uint8_t i = 0; i < ALARM_COUNT; ++i) {
+        if (ALARM_TABLE[i].channel == ch) return (AlarmLevel)alarms_[i].level;
+    }
+    return AlarmLevel::NONE;
+}
+
+ECUData::ChannelMask SyncManager::activeAlarms() const {
+    ECUData::ChannelMask mask = 0;
+    if (clt_trend_.alarm.level) mask |= ECUData::channelBit(ECUData::Channel::CLT);
+    if (battery_trend_.alarm.level) mask |= ECUData::channelBit(ECUData::Channel::BATTERY);
+    for (uint8_t i = 0; i < ALARM_COUNT; ++i) {
+        if (alarms_[i].level != (uint8_t)AlarmLevel::NONE || alarms_[i].latched) {
+            mask |= ECUData::channelBit(ALARM_TABLE[i].channel);
+        }
+    }
+    return mask;
+}
+
+void SyncManager::acknowledgeAlarms() {
+    // A latch whose committed level is still WARNING stays: the value has
+    // not come back inside the limits (plus hysteresis) yet
+    for (uint8_t i = 0; i < ALARM_COUNT; ++i) {
+        if (alarms_[i].level != (uint8_t)AlarmLevel::WARNING) alarms_[i].latched = false;
+    }
+    thresholds_changed_ = true;  // re-evaluate on the next update
+}
+
 void SyncManager::triggerSyncLoss() {
     handleStateTransition_(SyncState::SYNC_LOSS);
 }
@@ -117,7 +323,8 @@ uint8_t SyncManager::getRecoveryProgress() const {
     if (current_state_ != SyncState::RECOVERY) return 0;
     
     uint32_t elapsed = millis() - state_enter_time_;
-    uint32_t progress = (elapsed * 100) / thresholds_.recovery_delay_ms;
+    uint32_t delay_ms = recoveryDelay_();
+    uint32_t progress = delay_ms ? (elapsed * 100) / delay_ms : 100;
     return (progress > 100) ? 100 : progress;
 }
 
@@ -134,30 +341,57 @@ void SyncManager::handleStateTransition_(SyncState new_state) {
     state_changed_ = true;
     
     // Debug output
-    Serial.print("[SyncManager] State: ");
+    Serial.print(F("[SyncManager] State: "));
     Serial.print(getStateString());
-    Serial.print(" (from ");
+    Serial.print(F(" (from "));
     switch (previous_state_) {
-        case SyncState::NORMAL:    Serial.print("NORMAL"); break;
-        case SyncState::CAUTION:   Serial.print("CAUTION"); break;
-        case SyncState::WARNING:   Serial.print("WARNING"); break;
-        case SyncState::SYNC_LOSS: Serial.print("SYNC_LOSS"); break;
-        case SyncState::RECOVERY:  Serial.print("RECOVERY"); break;
-        default: Serial.print("UNKNOWN");
+        case SyncState::NORMAL:    Serial.print(F("NORMAL")); break;
+        case SyncState::CAUTION:   Serial.print(F("CAUTION")); break;
+        case SyncState::WARNING:   Serial.print(F("WARNING")); break;
+        case SyncState::SYNC_LOSS: Serial.print(F("SYNC_LOSS")); break;
+        case SyncState::RECOVERY:  Serial.print(F("RECOVERY")); break;
+        default: Serial.print(F("UNKNOWN"));
     }
-    Serial.println(")");
+    Serial.println(F(")"));
 }
 
 void SyncManager::debugPrint() const {
-    Serial.println("\n=== SyncManager ===");
-    Serial.print("State: "); Serial.println(getStateString());
-    Serial.print("Elapsed: "); Serial.print(getStateElapsedTime()); Serial.println(" ms");
+    Serial.println(F("\n=== SyncManager ==="));
+    Serial.print(F("State: ")); Serial.println(getStateString());
+    Serial.print(F("Elapsed: ")); Serial.print(getStateElapsedTime()); Serial.println(F(" ms"));
     if (current_state_ == SyncState::RECOVERY) {
-        Serial.print("Recovery Progress: "); Serial.print(getRecoveryProgress()); Serial.println("%");
+        Serial.print(F("Recovery Progress: ")); Serial.print(getRecoveryProgress()); Serial.println(F("%"));
+    }
+    if (clt_trend_.fit.full()) {
+        Serial.print(F("CLT trend: ")); Serial.print(clt_trend_.rate); Serial.print(F(" C/min"));
+        if (clt_trend_.ttl_s >= 0) { Serial.print(F(", limit in ")); Serial.print(clt_trend_.ttl_s); Serial.print(F(" s")); }
+        Serial.println();
+        Serial.print(F("BAT trend: ")); Serial.print(battery_trend_.rate); Serial.print(F(" mV/min"));
+        if (battery_trend_.ttl_s >= 0) { Serial.print(F(", limit in ")); Serial.print(battery_trend_.ttl_s); Serial.print(F(" s")); }
+        Serial.println();
     }
 }
 
 bool SyncManager::hasValidData_(const ECUData &ecu_data) const {
     // Data dianggap valid jika data tidak stale dan flag valid diset
-    return ecu_data.isDataValid && !ecu_data.isStale(thresholds_.data_timeout_ms);
+    return ecu_data.isDataValid && !ecu_data.isStale(dataTimeout_());
+}
+
+uint32_t SyncManager::dataTimeout_() const {
+    return link_ ? link_->timeoutMs(thresholds_.data_timeout_ms) : thresholds_.data_timeout_ms;
+}
+
+uint32_t SyncManager::recoveryDelay_() const {
+    // A slow link needs as many frames to prove itself as a fast one
+    uint32_t d = thresholds_.recovery_delay_ms;
+    if (link_ && link_->hasEstimate()) {
+        uint32_t frames_time = (uint32_t)link_->intervalMs() * 8;
+        if (frames_time > d) d = frames_time;
+    }
+    return d;
+}
+
+bool SyncManager::linkFlaky_() const {
+    return link_ && thresholds_.link_loss_error_pct &&
+           link_->errorPercent() >= thresholds_.link_loss_error_pct;
 }
@@ -4,98 +4,141 @@ UIScreen::UIScreen(DisplayManager &display)
     : display_(display) {
 }
 
-void UIScreen::render(const ECUData &ecu_data,
-                      const SyncManager &sync_mgr,
-                      const UIStateMachine &ui_state) {
-    
-    // SYNC_LOSS override: full-screen warning
-    if (sync_mgr.getState() == SyncManager::SyncState::SYNC_LOSS) {
-        // Redraw only when FULL_SCREEN slice is dirty (blink toggle/state change)
-        if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-            renderSyncLossScreen_(sync_mgr, ui_state);
-        }
-        return;
-    }
+ECUData::ChannelMask UIScreen::requiredChannels() const {
+    return ECUData::channelBit(ECUData::Channel::RPM) |
+           ECUData::channelBit(ECUData::Channel::MAP) |
+           ECUData::channelBit(ECUData::Channel::CLT) |
+           ECUData::channelBit(ECUData::Channel::IAT) |
+           ECUData::channelBit(ECUData::Channel::AFR) |
+           ECUData::channelBit(ECUData::Channel::TPS) |
+           ECUData::channelBit(ECUData::Channel::BATTERY);
+}
 
-    // BOOT: perangkat baru menyala, belum ada data
-    if (ecu_data.lastUpdateMillis == 0) {
-        if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-            renderBootSelfTest_();
+UIStateMachine::WidgetMask UIScreen::render(const ECUData &ecu_data,
+                                            const SyncManager &sync_mgr,
+                                            const UIStateMachine &ui_state) {
+    using UI = UIStateMachine;
+    using Ch = ECUData::Channel;
+    UI::WidgetMask dirty = ui_state.dirtyWidgets();
+
+    // A page switch repaints the new page from scratch
+    Page page = pageFor_(ecu_data, sync_mgr);
+    bool entered = page != page_;
+    page_ = page;
+
+    // Full-page views (SYNC_LOSS blink, peak recall, BOOT/WAIT/SYNCING,
+    // RECOVERY) are one widget: drawn on entry, state change or blink toggle
+    if (page != Page::GRID) {
+        if (!entered && !(dirty & UI::widgetBit(UI::Widget::FULL_SCREEN))) return 0;
+        switch (page) {
+            case Page::SYNC_LOSS:   renderSyncLossScreen_(sync_mgr, ui_state); break;
+            case Page::PEAK_RECALL: renderPeakRecall_(); break;
+            case Page::BOOT:        renderBootSelfTest_(); break;
+            case Page::WAIT_ECU:    renderWaitECU_(); break;
+            case Page::SYNCING:     renderSyncing_(); break;
+            case Page::RECOVERY:    renderRecovery_(); break;
+            default: break;
         }
-        return;
+        return UI::widgetBit(UI::Widget::FULL_SCREEN);
     }
 
-    // WAIT ECU / NO DATA: belum ada frame valid
-    if (!ecu_data.isDataValid) {
-        if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-            renderWaitECU_();
-        }
-        return;
+    // Back on the grid: every widget repaints. Change bits raised while
+    // another page was up were never consumed by the smoother, so let
+    // every channel converge again.
+    if (entered) {
+        for (int i = 0; i < 6; ++i) prevVals_[i][0] = '\0';
+        prevBat_[0] = '\0';
+        settling_ |= ECUData::CORE_CHANNELS;
+        dirty = UI::ALL_WIDGETS;
     }
 
-    // SYNCING: data masuk tapi belum sinkron
-    if (!ecu_data.isSynced) {
-        if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-            renderSyncing_();
-        }
-        return;
+    // Cells: formatted when dirty (data, colour, link flags) or when the
+    // smoothed value moved; drawn only if the text or colour differs
+    redraw_ = updateSmooth_(ecu_data);
+    for (uint8_t i = 0; i < 6; ++i) {
+        if (dirty & UI::widgetsFor(CELL_CHANNELS[i])) redraw_ |= ECUData::channelBit(CELL_CHANNELS[i]);
     }
-
-    // RECOVERY: masa pemulihan, tampilkan layar khusus
-    if (sync_mgr.getState() == SyncManager::SyncState::RECOVERY) {
-        if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-            renderRecovery_();
-        }
-        return;
+    SyncManager::AlarmLevel afr_level = sync_mgr.getAlarmLevel(ECUData::Channel::AFR);
+    if (afr_level != afrLevel_) {
+        afrLevel_ = afr_level;
+        redraw_ |= ECUData::channelBit(ECUData::Channel::AFR);
     }
-    
-    // Normal rendering dengan dirty-flag optimization
-    updateSmooth_(ecu_data);
-    // If fullscreen was dirty (e.g., coming from SYNC_LOSS/RECOVERY/WAIT/BOOT),
-    // ensure we force values to redraw by clearing previous cache.
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::FULL_SCREEN)) {
-        for (int i = 0; i < 6; ++i) {
-            prevVals_[i][0] = '\0';
-        }
+    // Full-page views are not shown on the grid; the next one repaints on entry
+    UI::WidgetMask done = UI::widgetBit(UI::Widget::FULL_SCREEN);
+    for (uint8_t i = 0; i < 6; ++i) {
+        if (redraw_ & ECUData::channelBit(CELL_CHANNELS[i])) done |= UI::widgetsFor(CELL_CHANNELS[i]);
     }
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::HEADER)) {
-        renderHeader_(ecu_data, sync_mgr, ui_state);
+
+    UI::WidgetMask header = dirty & HEADER_WIDGETS;
+    if (header) {
+        renderHeader_(ecu_data, sync_mgr, header);
+        done |= header;
     }
     
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::RPM_FIELD)) {
+    if (redraw_ & ECUData::channelBit(Ch::RPM)) {
         renderRPMField_(ecu_data, sync_mgr);
     }
     
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::ENGINE_CORE)) {
+    if (redraw_ & (ECUData::channelBit(Ch::MAP) | ECUData::channelBit(Ch::CLT))) {
         renderEngineCore_(ecu_data, sync_mgr);
     }
     
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::CONTROL_DATA)) {
+    if (redraw_ & (ECUData::channelBit(Ch::IAT) | ECUData::channelBit(Ch::AFR) |
+                   ECUData::channelBit(Ch::TPS))) {
         renderControlData_(ecu_data, sync_mgr);
     }
     
-    if (ui_state.isSliceDirty(UIStateMachine::UISlice::FOOTER)) {
+    if (dirty & UI::widgetBit(UI::Widget::FOOTER_STATE)) {
         renderFooter_(ecu_data, sync_mgr, ui_state);
+        done |= UI::widgetBit(UI::Widget::FOOTER_STATE);
     }
+    // Polled every frame: the lazy read is free unless fuel was integrated
+    renderFuel_((dirty & UI::widgetBit(UI::Widget::FOOTER_FUEL)) != 0);
+    done |= UI::widgetBit(UI::Widget::FOOTER_FUEL);
+    return done;
+}
+
+UIScreen::Page UIScreen::pageFor_(const ECUData &ecu_data, const SyncManager &sync_mgr) const {
+    if (sync_mgr.getState() == SyncManager::SyncState::SYNC_LOSS) return Page::SYNC_LOSS;
+    if (peak_stats_) return Page::PEAK_RECALL;            // ringkasan sesi setelah mesin mati
+    if (ecu_data.lastUpdateMillis == 0) return Page::BOOT; // belum ada data
+    if (!ecu_data.isDataValid) return Page::WAIT_ECU;     // belum ada frame valid
+    if (!ecu_data.isSynced) return Page::SYNCING;         // data masuk tapi belum sinkron
+    if (sync_mgr.getState() == SyncManager::SyncState::RECOVERY) return Page::RECOVERY;
+    return Page::GRID;
+}
+
+bool UIScreen::cellChanged_(uint8_t cell, const char *value, DisplayManager::Color color) {
+    if (prevColors_[cell] == color && strcmp(prevVals_[cell], value) == 0) return false;
+    prevColors_[cell] = color;
+    strncpy(prevVals_[cell], value, sizeof(prevVals_[cell]) - 1);
+    prevVals_[cell][sizeof(prevVals_[cell]) - 1] = '\0';
+    return true;
 }
 
 void UIScreen::renderHeader_(const ECUData &ecu_data,
                              const SyncManager &sync_mgr,
-                             const UIStateMachine &ui_state) {
+                             UIStateMachine::WidgetMask widgets) {
+    using UI = UIStateMachine;
     // Header bar: ECU | SYNC | BAT — dengan garis pemisah
-    display_.fillRect(0, HEADER_Y, 320, HEADER_H, DisplayManager::Color::BLACK);
-    display_.drawLine(0, HEADER_Y + HEADER_H - 1, 319, HEADER_Y + HEADER_H - 1, DisplayManager::Color::WHITE);
+    if ((widgets & HEADER_WIDGETS) == HEADER_WIDGETS) {
+        display_.fillRect(0, HEADER_Y, 320, HEADER_H, DisplayManager::Color::BLACK);
+        display_.drawLine(0, HEADER_Y + HEADER_H - 1, 319, HEADER_Y + HEADER_H - 1, DisplayManager::Color::WHITE);
+        prevBat_[0] = '\0';  // BAT was cleared too: repaint even if unchanged
+    }
 
     // Tiga kolom seimbang
     const uint16_t colW = 106; // ~320/3
     const uint16_t padX = 6;
     const uint16_t baseY = HEADER_Y + 4;
+    display_.setTextSize(1);
 
     // ECU status (kiri)
-    display_.setTextSize(1);
+    if (widgets & UI::widgetBit(UI::Widget::HEADER_ECU)) {
+    display_.fillRect(0, HEADER_Y, colW, HEADER_H - 1, DisplayManager::Color::BLACK);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(padX, baseY);
-    display_.print("ECU");
+    display_.print(F("ECU"));
     display_.setCursor(padX + 30, baseY);
     const char* ecuTxt = headerEcuStatusText_(ecu_data, sync_mgr);
     DisplayManager::Color ecuCol = ecu_data.isDataValid ? DisplayManager::Color::GREEN : DisplayManager::Color::AMBER;
@@ -110,27 +153,36 @@ void UIScreen::renderHeader_(const ECUData &ecu_data,
         snprintf(recStr, sizeof(recStr), "%d%%", sync_mgr.getRecoveryProgress());
         display_.print(recStr);
     }
+    }
 
     // SYNC (tengah)
+    if (widgets & UI::widgetBit(UI::Widget::HEADER_SYNC)) {
+    display_.fillRect(colW, HEADER_Y, colW, HEADER_H - 1, DisplayManager::Color::BLACK);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(colW + padX, baseY);
-    display_.print("SYNC");
+    display_.print(F("SYNC"));
     display_.setCursor(colW + padX + 36, baseY);
     char syncStr[16];
     snprintf(syncStr, sizeof(syncStr), "%d", ecu_data.syncLossCounter);
     display_.setTextColor(DisplayManager::Color::AMBER, DisplayManager::Color::BLACK);
     display_.print(syncStr);
+    }
 
-    // BAT (kanan)
-    display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
-    display_.setCursor(colW*2 + padX, baseY);
-    display_.print("BAT");
-    display_.setCursor(colW*2 + padX + 28, baseY);
-    char batStr[16];
+    // BAT (kanan): mV noise below the shown 0.1 V does not repaint
+    if (widgets & UI::widgetBit(UI::Widget::HEADER_BAT)) {
+    char batStr[8];
     snprintf(batStr, sizeof(batStr), "%.1fV", ecu_data.battery / 1000.0);
-    // Warna hanya untuk status: nilai tetap putih
-    display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
-    display_.print(batStr);
+    if (strcmp(prevBat_, batStr) != 0) {
+        strcpy(prevBat_, batStr);
+        display_.fillRect(colW * 2, HEADER_Y, 320 - colW * 2, HEADER_H - 1, DisplayManager::Color::BLACK);
+        display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
+        display_.setCursor(colW*2 + padX, baseY);
+        display_.print(F("BAT"));
+        display_.setCursor(colW*2 + padX + 28, baseY);
+        // Warna hanya untuk status: nilai tetap putih
+        display_.print(batStr);
+    }
+    }
 }
 
 void UIScreen::renderRPMField_(const ECUData &ecu_data,
@@ -143,10 +195,8 @@ void UIScreen::renderRPMField_(const ECUData &ecu_data,
         strcpy(rpmStr, "--");
         valCol = DisplayManager::Color::AMBER;
     }
-    // Skip redraw if unchanged
-    if (strcmp(prevVals_[0], rpmStr) != 0) {
-        strncpy(prevVals_[0], rpmStr, sizeof(prevVals_[0]) - 1);
-        prevVals_[0][sizeof(prevVals_[0]) - 1] = '\0';
+    // Skip redraw if text and colour are unchanged
+    if (cellChanged_(0, rpmStr, valCol)) {
         drawGridCell_(0, GRID_ROW1_Y, CELL_W, GRID_ROW1_H,
                       "RPM", rpmStr,
                       DisplayManager::Color::WHITE,
@@ -158,112 +208,116 @@ void UIScreen::renderRPMField_(const ECUData &ecu_data,
 
 void UIScreen::renderEngineCore_(const ECUData &ecu_data,
                                 const SyncManager &sync_mgr) {
+    DisplayManager::Color valCol;
+
     // Row-1, Col-2: MAP
-    int mapDisp = (int)(smooth_.map + 0.5f);
-    char mapStr[16]; snprintf(mapStr, sizeof(mapStr), "%d", mapDisp);
-    DisplayManager::Color valCol = valueColorForState_(sync_mgr.getState());
-    if (sync_mgr.getState() == SyncManager::SyncState::NO_DATA || !ecu_data.isDataValid) {
-        strcpy(mapStr, "--");
-        valCol = DisplayManager::Color::AMBER;
-    }
-    if (strcmp(prevVals_[1], mapStr) != 0) {
-        strncpy(prevVals_[1], mapStr, sizeof(prevVals_[1]) - 1);
-        prevVals_[1][sizeof(prevVals_[1]) - 1] = '\0';
-        drawGridCell_(CELL_W, GRID_ROW1_Y, CELL_W, GRID_ROW1_H,
-                      "MAP", mapStr,
-                      DisplayManager::Color::WHITE,
-                      valCol,
-                      borderColorForState_(sync_mgr.getState()),
-                      3);
+    if (redraw_ & ECUData::channelBit(ECUData::Channel::MAP)) {
+        int mapDisp = (int)(smooth_.map + 0.5f);
+        char mapStr[16]; snprintf(mapStr, sizeof(mapStr), "%d", mapDisp);
+        valCol = valueColorForState_(sync_mgr.getState());
+        if (sync_mgr.getState() == SyncManager::SyncState::NO_DATA || !ecu_data.isDataValid) {
+            strcpy(mapStr, "--");
+            valCol = DisplayManager::Color::AMBER;
+        }
+        if (cellChanged_(1, mapStr, valCol)) {
+            drawGridCell_(CELL_W, GRID_ROW1_Y, CELL_W, GRID_ROW1_H,
+                          "MAP", mapStr,
+                          DisplayManager::Color::WHITE,
+                          valCol,
+                          borderColorForState_(sync_mgr.getState()),
+                          3);
+        }
     }
 
     // Row-1, Col-3: CLT
-    char cltStr[16];
-    if (!ecu_data.isDataValid) {
-        strcpy(cltStr, "--");
-        valCol = DisplayManager::Color::AMBER;
-    } else {
-        annotateClt_(cltStr, sizeof(cltStr), (int16_t)(smooth_.clt + 0.5f), sync_mgr);
-        valCol = valueColorForState_(sync_mgr.getState());
-    }
-    if (strcmp(prevVals_[2], cltStr) != 0) {
-        strncpy(prevVals_[2], cltStr, sizeof(prevVals_[2]) - 1);
-        prevVals_[2][sizeof(prevVals_[2]) - 1] = '\0';
-        drawGridCell_(CELL_W * 2, GRID_ROW1_Y, CELL_W, GRID_ROW1_H,
-                      "CLT", cltStr,
-                      DisplayManager::Color::WHITE,
-                      valCol,
-                      borderColorForState_(sync_mgr.getState()),
-                      3);
+    if (redraw_ & ECUData::channelBit(ECUData::Channel::CLT)) {
+        char cltStr[16];
+        if (!ecu_data.isDataValid) {
+            strcpy(cltStr, "--");
+            valCol = DisplayManager::Color::AMBER;
+        } else {
+            annotateClt_(cltStr, sizeof(cltStr), (int16_t)(smooth_.clt + 0.5f), sync_mgr);
+            valCol = valueColorForState_(sync_mgr.getState());
+        }
+        if (cellChanged_(2, cltStr, valCol)) {
+            drawGridCell_(CELL_W * 2, GRID_ROW1_Y, CELL_W, GRID_ROW1_H,
+                          "CLT", cltStr,
+                          DisplayManager::Color::WHITE,
+                          valCol,
+                          borderColorForState_(sync_mgr.getState()),
+                          3);
+        }
     }
 }
 
 void UIScreen::renderControlData_(const ECUData &ecu_data,
                                  const SyncManager &sync_mgr) {
+    DisplayManager::Color valCol;
+
     // Row-2, Col-1: IAT
-    int iatDisp = (int)(smooth_.iat + 0.5f);
-    char iatStr[16]; snprintf(iatStr, sizeof(iatStr), "%d", iatDisp);
-    DisplayManager::Color valCol = valueColorForState_(sync_mgr.getState());
-    if (!ecu_data.isDataValid) {
-        strcpy(iatStr, "--");
-        valCol = DisplayManager::Color::AMBER;
-    }
-    if (strcmp(prevVals_[3], iatStr) != 0) {
-        strncpy(prevVals_[3], iatStr, sizeof(prevVals_[3]) - 1);
-        prevVals_[3][sizeof(prevVals_[3]) - 1] = '\0';
-        drawGridCell_(0, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
-                      "IAT", iatStr,
-                      DisplayManager::Color::WHITE,
-                      valCol,
-                      borderColorForState_(sync_mgr.getState()),
-                      3);
+    if (redraw_ & ECUData::channelBit(ECUData::Channel::IAT)) {
+        int iatDisp = (int)(smooth_.iat + 0.5f);
+        char iatStr[16]; snprintf(iatStr, sizeof(iatStr), "%d", iatDisp);
+        valCol = valueColorForState_(sync_mgr.getState());
+        if (!ecu_data.isDataValid) {
+            strcpy(iatStr, "--");
+            valCol = DisplayManager::Color::AMBER;
+        }
+        if (cellChanged_(3, iatStr, valCol)) {
+            drawGridCell_(0, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
+                          "IAT", iatStr,
+                          DisplayManager::Color::WHITE,
+                          valCol,
+                          borderColorForState_(sync_mgr.getState()),
+                          3);
+        }
     }
 
     // Row-2, Col-2: AFR
-    char afrStr[16];
-    if (!ecu_data.isDataValid) {
-        strcpy(afrStr, "--");
-        valCol = DisplayManager::Color::AMBER;
-    } else {
-        annotateAfr_(afrStr, sizeof(afrStr), (uint16_t)(smooth_.afr_x100 + 0.5f), sync_mgr);
-        valCol = valueColorForState_(sync_mgr.getState());
-    }
-    if (strcmp(prevVals_[4], afrStr) != 0) {
-        strncpy(prevVals_[4], afrStr, sizeof(prevVals_[4]) - 1);
-        prevVals_[4][sizeof(prevVals_[4]) - 1] = '\0';
-        drawGridCell_(CELL_W, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
-                      "AFR", afrStr,
-                      DisplayManager::Color::WHITE,
-                      valCol,
-                      borderColorForState_(sync_mgr.getState()),
-                      3);
+    if (redraw_ & ECUData::channelBit(ECUData::Channel::AFR)) {
+        char afrStr[16];
+        if (!ecu_data.isDataValid) {
+            strcpy(afrStr, "--");
+            valCol = DisplayManager::Color::AMBER;
+        } else {
+            annotateAfr_(afrStr, sizeof(afrStr), (uint16_t)(smooth_.afr_x100 + 0.5f), sync_mgr);
+            valCol = valueColorForState_(sync_mgr.getState());
+        }
+        if (cellChanged_(4, afrStr, valCol)) {
+            drawGridCell_(CELL_W, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
+                          "AFR", afrStr,
+                          DisplayManager::Color::WHITE,
+                          valCol,
+                          borderColorForState_(sync_mgr.getState()),
+                          3);
+        }
     }
 
     // Row-2, Col-3: TPS
-    int tpsDisp = (int)(smooth_.tps + 0.5f);
-    char tpsStr[16]; snprintf(tpsStr, sizeof(tpsStr), "%d", tpsDisp);
-    valCol = valueColorForState_(sync_mgr.getState());
-    if (!ecu_data.isDataValid) {
-        strcpy(tpsStr, "--");
-        valCol = DisplayManager::Color::AMBER;
-    }
-    if (strcmp(prevVals_[5], tpsStr) != 0) {
-        strncpy(prevVals_[5], tpsStr, sizeof(prevVals_[5]) - 1);
-        prevVals_[5][sizeof(prevVals_[5]) - 1] = '\0';
-        drawGridCell_(CELL_W * 2, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
-                      "TPS", tpsStr,
-                      DisplayManager::Color::WHITE,
-                      valCol,
-                      borderColorForState_(sync_mgr.getState()),
-                      3);
+    if (redraw_ & ECUData::channelBit(ECUData::Channel::TPS)) {
+        int tpsDisp = (int)(smooth_.tps + 0.5f);
+        char tpsStr[16]; snprintf(tpsStr, sizeof(tpsStr), "%d", tpsDisp);
+        valCol = valueColorForState_(sync_mgr.getState());
+        if (!ecu_data.isDataValid) {
+            strcpy(tpsStr, "--");
+            valCol = DisplayManager::Color::AMBER;
+        }
+        if (cellChanged_(5, tpsStr, valCol)) {
+            drawGridCell_(CELL_W * 2, GRID_ROW2_Y, CELL_W, GRID_ROW2_H,
+                          "TPS", tpsStr,
+                          DisplayManager::Color::WHITE,
+                          valCol,
+                          borderColorForState_(sync_mgr.getState()),
+                          3);
+        }
     }
 }
 
 void UIScreen::renderFooter_(const ECUData &ecu_data,
                             const SyncManager &sync_mgr,
                             const UIStateMachine &ui_state) {
-    // Footer: Status atau FUEL x.xx L (placeholder) — dengan garis pemisah
-    display_.fillRect(0, FOOTER_Y, 320, FOOTER_H, DisplayManager::Color::BLACK);
+    // Footer kiri: status — dengan garis pemisah (FUEL di kanan: renderFuel_)
+    display_.fillRect(0, FOOTER_Y, FUEL_X, FOOTER_H, DisplayManager::Color::BLACK);
     display_.drawLine(0, FOOTER_Y, 319, FOOTER_Y, DisplayManager::Color::WHITE);
 
     display_.setTextSize(1);
@@ -273,10 +327,27 @@ void UIScreen::renderFooter_(const ECUData &ecu_data,
     const char *state_str = getStateName_(sync_mgr.getState());
     display_.setCursor(6, FOOTER_Y + 4);
     display_.print(state_str);
+}
 
-    // FUEL (jika ada; placeholder)
-    display_.setCursor(220, FOOTER_Y + 4);
-    display_.print("FUEL: --.- L");
+void UIScreen::renderFuel_(bool force) {
+    char fuelStr[20];
+    if (derived_) {
+        // Lazy: recomputed only if the integrator advanced since last read
+        uint32_t used = (uint32_t)derived_->get(DerivedChannels::Id::FUEL_USED);  // 0.01 L
+        // ">" when frame gaps went uncounted: the total is a lower bound
+        snprintf(fuelStr, sizeof(fuelStr), "FUEL: %s%lu.%lu L", derived_->getFuelGapMs() ? ">" : "",
+                 (unsigned long)(used / 100), (unsigned long)(used % 100 / 10));
+    } else {
+        strcpy(fuelStr, "FUEL: --.- L");
+    }
+    if (!force && strcmp(prevFuel_, fuelStr) == 0) return;
+    strncpy(prevFuel_, fuelStr, sizeof(prevFuel_) - 1);
+    prevFuel_[sizeof(prevFuel_) - 1] = '\0';
+    display_.fillRect(FUEL_X, FOOTER_Y + 1, 320 - FUEL_X, FOOTER_H - 1, DisplayManager::Color::BLACK);
+    display_.setTextSize(1);
+    display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
+    display_.setCursor(FUEL_X, FOOTER_Y + 4);
+    display_.print(fuelStr);
 }
 
 void UIScreen::renderSyncLossScreen_(const SyncManager &sync_mgr,
@@ -448,7 +519,8 @@ void UIScreen::drawGridValueArea_(uint16_t x, uint16_t y, uint16_t w, uint16_t h
 }
 
 // ===== Smoothing helpers =====
-void UIScreen::updateSmooth_(const ECUData &ecu) {
+ECUData::ChannelMask UIScreen::updateSmooth_(const ECUData &ecu) {
+    using Ch = ECUData::Channel;
     // Parameter-specific smoothing factors (higher = faster response)
     const float alpha_rpm = 0.35f;
     const float alpha_map = 0.30f;
@@ -466,15 +538,33 @@ void UIScreen::updateSmooth_(const ECUData &ecu) {
         smooth_.tps = ecu.tps;
         smooth_.battery = ecu.battery;
         smooth_.initialized = true;
-        return;
+        settling_ = 0;
+        return ECUData::CORE_CHANNELS;
+    }
+    // Only channels with a new raw value or a filter still converging are
+    // touched; settled, unchanged channels cost one mask test each
+    ECUData::ChannelMask pending = ecu.changedChannels() | settling_;
+    settling_ = 0;
+    if (pending & ECUData::channelBit(Ch::RPM)) approach_(Ch::RPM, smooth_.rpm, (float)ecu.rpm, alpha_rpm);
+    if (pending & ECUData::channelBit(Ch::MAP)) approach_(Ch::MAP, smooth_.map, (float)ecu.map, alpha_map);
+    if (pending & ECUData::channelBit(Ch::CLT)) approach_(Ch::CLT, smooth_.clt, (float)ecu.clt, alpha_clt);
+    if (pending & ECUData::channelBit(Ch::IAT)) approach_(Ch::IAT, smooth_.iat, (float)ecu.iat, alpha_iat);
+    if (pending & ECUData::channelBit(Ch::AFR)) approach_(Ch::AFR, smooth_.afr_x100, (float)ecu.afr, alpha_afr);
+    if (pending & ECUData::channelBit(Ch::TPS)) approach_(Ch::TPS, smooth_.tps, (float)ecu.tps, alpha_tps);
+    if (pending & ECUData::channelBit(Ch::BATTERY)) approach_(Ch::BATTERY, smooth_.battery, (float)ecu.battery, alpha_bat);
+    return pending & ECUData::CORE_CHANNELS;
+}
+
+// One filter step; snaps to the target once within SETTLE_EPS so the
+// channel drops out of settling_ instead of creeping forever
+void UIScreen::approach_(ECUData::Channel ch, float &value, float target, float alpha) {
+    value = lerp_(value, target, alpha);
+    float diff = target - value;
+    if (diff > SETTLE_EPS || diff < -SETTLE_EPS) {
+        settling_ |= ECUData::channelBit(ch);
+    } else {
+        value = target;
     }
-    smooth_.rpm = lerp_(smooth_.rpm, (float)ecu.rpm, alpha_rpm);
-    smooth_.map = lerp_(smooth_.map, (float)ecu.map, alpha_map);
-    smooth_.clt = lerp_(smooth_.clt, (float)ecu.clt, alpha_clt);
-    smooth_.iat = lerp_(smooth_.iat, (float)ecu.iat, alpha_iat);
-    smooth_.afr_x100 = lerp_(smooth_.afr_x100, (float)ecu.afr, alpha_afr);
-    smooth_.tps = lerp_(smooth_.tps, (float)ecu.tps, alpha_tps);
-    smooth_.battery = lerp_(smooth_.battery, (float)ecu.battery, alpha_bat);
 }
 
 float UIScreen::lerp_(float from, float to, float alpha) {
@@ -520,6 +610,11 @@ DisplayManager::Color UIScreen::borderColorForState_(SyncManager::SyncState stat
     }
 }
 
+void UIScreen::showPeakRecall(const SessionStats *stats) {
+    // Page switch in render() repaints in both directions
+    peak_stats_ = stats;
+}
+
 // ===== Fullscreen state renderers =====
 void UIScreen::renderBootSelfTest_() {
     // Avionics-style self-test page
@@ -533,33 +628,68 @@ void UIScreen::renderBootSelfTest_() {
     display_.setTextSize(2);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(x + 10, y + 12);
-    display_.print("ECU MONITOR");
+    display_.print(F("ECU MONITOR"));
 
     // Items
     uint16_t lineY = y + 50;
     display_.setTextSize(2);
     display_.setCursor(x + 10, lineY);
-    display_.print("TFT   ");
+    display_.print(F("TFT   "));
     display_.setTextColor(DisplayManager::Color::GREEN, DisplayManager::Color::BLACK);
-    display_.print("OK");
+    display_.print(F("OK"));
 
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(x + 10, lineY + 30);
-    display_.print("MCU   ");
+    display_.print(F("MCU   "));
     display_.setTextColor(DisplayManager::Color::GREEN, DisplayManager::Color::BLACK);
-    display_.print("OK");
+    display_.print(F("OK"));
 
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(x + 10, lineY + 60);
-    display_.print("BUS   ");
+    display_.print(F("BUS   "));
     display_.setTextColor(DisplayManager::Color::GREEN, DisplayManager::Color::BLACK);
-    display_.print("OK");
+    display_.print(F("OK"));
 
     // Footer INIT... — static text, tidak blink
     display_.setTextSize(2);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(x + 10, y + h - 28);
-    display_.print("INIT...");
+    display_.print(F("INIT..."));
+}
+
+void UIScreen::renderPeakRecall_() {
+    using Ch = ECUData::Channel;
+    const SessionStats &st = *peak_stats_;
+    display_.fillScreen(DisplayManager::Color::BLACK);
+
+    const uint16_t x = 20, y = 20, w = 280, h = 200;
+    display_.drawBox(x, y, w, h, DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
+
+    display_.setTextSize(2);
+    display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
+    display_.setCursor(x + 10, y + 10);
+    display_.print(F("SESSION PEAKS"));
+
+    char line[24];
+    uint16_t lineY = y + 42;
+    display_.setTextColor(DisplayManager::Color::GREEN, DisplayManager::Color::BLACK);
+    snprintf(line, sizeof(line), "RPM max %d", st.maximum(Ch::RPM));
+    display_.setCursor(x + 10, lineY); display_.print(line);
+    snprintf(line, sizeof(line), "CLT max %dC", st.maximum(Ch::CLT));
+    display_.setCursor(x + 10, lineY + 26); display_.print(line);
+    snprintf(line, sizeof(line), "BAT min %d.%dV", st.minimum(Ch::BATTERY) / 1000,
+             (st.minimum(Ch::BATTERY) % 1000) / 100);
+    display_.setCursor(x + 10, lineY + 52); display_.print(line);
+    int32_t afr = st.mean(Ch::AFR);
+    snprintf(line, sizeof(line), "AFR avg %ld.%02ld", (long)(afr / 100), (long)(afr % 100));
+    display_.setCursor(x + 10, lineY + 78); display_.print(line);
+    snprintf(line, sizeof(line), "MAP max %d", st.maximum(Ch::MAP));
+    display_.setCursor(x + 10, lineY + 104); display_.print(line);
+
+    display_.setTextSize(1);
+    display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
+    snprintf(line, sizeof(line), "%lu frames", (unsigned long)st.samples());
+    display_.setCursor(x + 10, y + h - 14); display_.print(line);
 }
 
 void UIScreen::renderWaitECU_() {
@@ -573,23 +703,23 @@ void UIScreen::renderWaitECU_() {
     display_.setTextSize(2);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
     display_.setCursor(x + 10, y + 12);
-    display_.print("ECU MONITOR");
+    display_.print(F("ECU MONITOR"));
 
     // Status lines
     display_.setTextSize(2);
     display_.setCursor(x + 10, y + 50);
     display_.setTextColor(DisplayManager::Color::AMBER, DisplayManager::Color::BLACK);
-    display_.print("WAIT ECU");
+    display_.print(F("WAIT ECU"));
 
     display_.setTextSize(1);
     display_.setCursor(x + 10, y + 85);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
-    display_.print("SERIAL LINK");
+    display_.print(F("SERIAL LINK"));
 
     // Placeholders row
     display_.setCursor(x + 10, y + h - 40);
     display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
-    display_.print("RPM ---   CLT ---   AFR --");
+    display_.print(F("RPM ---   CLT ---   AFR --"));
 }
 
 void UIScreen::renderSyncing_() {
@@ -601,7 +731,7 @@ void UIScreen::renderSyncing_() {
     display_.setTextSize(1);
     display_.setTextColor(DisplayManager::Color::CYAN, DisplayManager::Color::DARK_GRAY);
     display_.setCursor(6, 6);
-    display_.print("SYNCING");
+    display_.print(F("SYNCING"));
 
     // Grid 3x2 dengan placeholder
     for (int row = 0; row < 2; row++) {
@@ -614,16 +744,16 @@ void UIScreen::renderSyncing_() {
             display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
             display_.setCursor(x + 6, y + 4);
             
-            if (row == 0 && col == 0) display_.print("RPM");
-            else if (row == 0 && col == 1) display_.print("MAP");
-            else if (row == 0 && col == 2) display_.print("CLT");
-            else if (row == 1 && col == 0) display_.print("IAT");
-            else if (row == 1 && col == 1) display_.print("AFR");
-            else if (row == 1 && col == 2) display_.print("TPS");
+            if (row == 0 && col == 0) display_.print(F("RPM"));
+            else if (row == 0 && col == 1) display_.print(F("MAP"));
+            else if (row == 0 && col == 2) display_.print(F("CLT"));
+            else if (row == 1 && col == 0) display_.print(F("IAT"));
+            else if (row == 1 && col == 1) display_.print(F("AFR"));
+            else if (row == 1 && col == 2) display_.print(F("TPS"));
             
             display_.setTextSize(2);
             display_.setCursor(x + 10, y + 45);
-            display_.print("--");
+            display_.print(F("--"));
         }
     }
 }
@@ -637,7 +767,7 @@ void UIScreen::renderRecovery_() {
     display_.setTextSize(1);
     display_.setTextColor(DisplayManager::Color::AMBER, DisplayManager::Color::DARK_GRAY);
     display_.setCursor(6, 6);
-    display_.print("RECOVERING");
+    display_.print(F("RECOVERING"));
 
     // Grid 3x2 dengan placeholder
     for (int row = 0; row < 2; row++) {
@@ -650,16 +780,16 @@ void UIScreen::renderRecovery_() {
             display_.setTextColor(DisplayManager::Color::WHITE, DisplayManager::Color::BLACK);
             display_.setCursor(x + 6, y + 4);
             
-            if (row == 0 && col == 0) display_.print("RPM");
-            else if (row == 0 && col == 1) display_.print("MAP");
-            else if (row == 0 && col == 2) display_.print("CLT");
-            else if (row == 1 && col == 0) display_.print("IAT");
-            else if (row == 1 && col == 1) display_.print("AFR");
-            else if (row == 1 && col == 2) display_.print("TPS");
+            if (row == 0 && col == 0) display_.print(F("RPM"));
+            else if (row == 0 && col == 1) display_.print(F("MAP"));
+            else if (row == 0 && col == 2) display_.print(F("CLT"));
+            else if (row == 1 && col == 0) display_.print(F("IAT"));
+            else if (row == 1 && col == 1) display_.print(F("AFR"));
+            else if (row == 1 && col == 2) display_.print(F("TPS"));
             
             display_.setTextSize(2);
             display_.setCursor(x + 10, y + 45);
-            display_.print("--");
+            display_.print(F("--"));
         }
     }
 }
@@ -693,27 +823,18 @@ void UIScreen::annotateClt_(char *buf, size_t bufSize, int16_t clt, const SyncMa
 }
 
 void UIScreen::annotateAfr_(char *buf, size_t bufSize, uint16_t afr, const SyncManager &sync_mgr) const {
-    const auto &th = sync_mgr.getThresholds();
     // Format AFR as XX.XX (100x)
     float afr_val = afr / 100.0f;
     char tmp[16];
     // Keep one decimal for compactness (e.g., 14.7)
     snprintf(tmp, sizeof(tmp), "%.1f", (double)afr_val);
 
-    // Determine severity
-    bool caution = false;
-    bool warning = false;
-    if (afr > th.afr_max) {
-        caution = true;
-        if (afr >= th.afr_max + 200) warning = true; // > +2.00 extremely lean
-    } else if (afr < th.afr_min) {
-        caution = true;
-        if (afr <= th.afr_min - 200) warning = true; // < -2.00 extremely rich
-    }
-
-    if (warning) {
+    // Severity from the AFR alarm itself: its limits follow the RPM/MAP
+    // tables, so the cell and the alarm state cannot disagree
+    SyncManager::AlarmLevel level = sync_mgr.getAlarmLevel(ECUData::Channel::AFR);
+    if (level == SyncManager::AlarmLevel::WARNING) {
         snprintf(buf, bufSize, "%s!!", tmp);
-    } else if (caution) {
+    } else if (level == SyncManager::AlarmLevel::CAUTION) {
         snprintf(buf, bufSize, "%s!", tmp);
     } else {
         snprintf(buf, bufSize, "%s", tmp);
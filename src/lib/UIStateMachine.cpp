@@ -3,21 +3,25 @@
 UIStateMachine::UIStateMachine()
     : current_ui_state_(SyncManager::SyncState::NORMAL),
       previous_ui_state_(SyncManager::SyncState::NORMAL),
-      dirty_flags_(0xFF),  // All slices dirty on startup
+      last_sync_counter_(0),
+      last_flags_(0),
       blink_state_(BlinkState::OFF),
       blink_timestamp_(0),
     blink_period_ms_(500),
     last_blink_on_(false) {
+    memset(gen_, 0, sizeof(gen_));
+    memset(drawn_gen_, 0, sizeof(drawn_gen_));
+    invalidate(ALL_WIDGETS);  // All widgets dirty on startup
 }
 
 void UIStateMachine::update(SyncManager::SyncState sync_state) {
     previous_ui_state_ = current_ui_state_;
     current_ui_state_ = sync_state;
-    
-    // State change detection
+
+    // State change detection: only widgets that show the state
     if (sync_state != previous_ui_state_) {
-        markAllDirty_();
-        
+        invalidate(STATE_WIDGETS);
+
         // Initialize blink state untuk SYNC_LOSS
         if (sync_state == SyncManager::SyncState::SYNC_LOSS) {
             blink_state_ = BlinkState::BLINKING;
@@ -26,42 +30,72 @@ void UIStateMachine::update(SyncManager::SyncState sync_state) {
             blink_state_ = BlinkState::OFF;
         }
     }
-    
+
     // Update blinking
     updateBlinkState_();
 }
 
-bool UIStateMachine::isSliceDirty(UISlice slice) const {
-    uint8_t bit = (uint8_t)slice;
-    return (dirty_flags_ & (1 << bit)) != 0;
+void UIStateMachine::noteData(const ECUData &ecu_data) {
+    WidgetMask widgets = 0;
+    ECUData::ChannelMask changed = ecu_data.changedChannels();
+    for (uint8_t ch = 0; changed; ++ch) {
+        ECUData::ChannelMask bit = ECUData::channelBit((ECUData::Channel)ch);
+        if (!(changed & bit)) continue;
+        changed &= ~bit;
+        widgets |= widgetsFor((ECUData::Channel)ch);
+    }
+
+    // Valid/synced flags switch the cells to "--" and the ECU status text
+    uint8_t flags = (uint8_t)((ecu_data.isDataValid ? 1 : 0) | (ecu_data.isSynced ? 2 : 0) |
+                              (ecu_data.lastUpdateMillis ? 4 : 0));
+    if (flags != last_flags_) {
+        last_flags_ = flags;
+        widgets |= CELL_WIDGETS | widgetBit(Widget::HEADER_ECU) | widgetBit(Widget::FULL_SCREEN);
+    }
+    if (ecu_data.syncLossCounter != last_sync_counter_) {
+        last_sync_counter_ = ecu_data.syncLossCounter;
+        widgets |= widgetBit(Widget::HEADER_SYNC);
+    }
+    if (widgets) invalidate(widgets);
 }
 
-void UIStateMachine::markSliceClean(UISlice slice) {
-    uint8_t bit = (uint8_t)slice;
-    dirty_flags_ &= ~(1 << bit);
+void UIStateMachine::invalidate(WidgetMask widgets) {
+    widgets &= ALL_WIDGETS;
+    for (uint8_t i = 0; widgets; ++i, widgets >>= 1) {
+        // Stop one short of wrapping onto the drawn generation: a widget
+        // hidden for 256+ changes must still read as dirty
+        if ((widgets & 1) && (uint8_t)(gen_[i] + 1) != drawn_gen_[i]) gen_[i]++;
+    }
+}
+
+void UIStateMachine::markDrawn(WidgetMask widgets) {
+    widgets &= ALL_WIDGETS;
+    for (uint8_t i = 0; widgets; ++i, widgets >>= 1) {
+        if (widgets & 1) drawn_gen_[i] = gen_[i];
+    }
+}
+
+UIStateMachine::WidgetMask UIStateMachine::dirtyWidgets() const {
+    WidgetMask dirty = 0;
+    for (uint8_t i = 0; i < WIDGET_COUNT; ++i) {
+        if (gen_[i] != drawn_gen_[i]) dirty |= (WidgetMask)1 << i;
+    }
+    return dirty;
 }
 
 bool UIStateMachine::shouldBlinkOn() const {
     if (blink_state_ != BlinkState::BLINKING) {
         return blink_state_ == BlinkState::ON;
     }
-    
+
     // Calculate blink cycle
     uint32_t elapsed = millis() - blink_timestamp_;
     uint32_t cycle_pos = elapsed % (blink_period_ms_ * 2);
     return cycle_pos < blink_period_ms_;
 }
 
-void UIStateMachine::markAllDirty_() {
-    dirty_flags_ = 0xFF;
-}
-
-void UIStateMachine::clearAllDirty_() {
-    dirty_flags_ = 0x00;
-}
-
 void UIStateMachine::updateBlinkState_() {
-    // Handle blink dirty flag for SYNC_LOSS fullscreen override
+    // Handle blink dirty bit for SYNC_LOSS fullscreen override
     if (current_ui_state_ == SyncManager::SyncState::SYNC_LOSS) {
         if (blink_state_ != BlinkState::BLINKING) {
             blink_state_ = BlinkState::BLINKING;
@@ -71,8 +105,8 @@ void UIStateMachine::updateBlinkState_() {
         uint32_t cycle_pos = elapsed % (blink_period_ms_ * 2);
         bool blink_on = cycle_pos < blink_period_ms_;
         if (blink_on != last_blink_on_) {
-            // Toggle occurred: mark fullscreen dirty for redraw
-            dirty_flags_ |= (1 << SLICE_FULLSCREEN);
+            // Toggle occurred: only the full-screen view changes
+            invalidate(widgetBit(Widget::FULL_SCREEN));
             last_blink_on_ = blink_on;
         }
     } else {
@@ -21,11 +21,15 @@
 
 // Include all OOP classes
 #include "ECUData.h"
+#include "ECUSnapshot.h"
 #include "SpeeduinoParser.h"
 #include "SyncManager.h"
 #include "DisplayManager.h"
 #include "UIStateMachine.h"
 #include "UIScreen.h"
+#include "History.h"
+#include "SessionStats.h"
+#include "DerivedChannels.h"
 
 // ============================================================================
 // PRIMARY 'A' DEBUG MODE (request 'A' and parse offsets)
@@ -58,8 +62,8 @@ float bat;
 void setup() {
     Serial.begin(115200);
     Serial1.begin(115200);
-    Serial.println("Dashboard Speeduino Siap...");
-    Serial.println("Menunggu data...");
+    Serial.println(F("Dashboard Speeduino Siap..."));
+    Serial.println(F("Menunggu data..."));
     delay(1000);
 }
 
@@ -72,13 +76,13 @@ void requestData() {
 }
 
 void printDebug() {
-    Serial.print("RPM: "); Serial.print(rpm);
-    Serial.print(" | TPS: "); Serial.print(tps); Serial.print("%");
-    Serial.print(" | MAP: "); Serial.print(map_val); Serial.print("kPa");
-    Serial.print(" | AFR: "); Serial.print(afr);
-    Serial.print(" | CLT: "); Serial.print(clt); Serial.print("C");
-    Serial.print(" | IAT: "); Serial.print(iat); Serial.print("C");
-    Serial.print(" | BAT: "); Serial.print(bat); Serial.println("V");
+    Serial.print(F("RPM: ")); Serial.print(rpm);
+    Serial.print(F(" | TPS: ")); Serial.print(tps); Serial.print(F("%"));
+    Serial.print(F(" | MAP: ")); Serial.print(map_val); Serial.print(F("kPa"));
+    Serial.print(F(" | AFR: ")); Serial.print(afr);
+    Serial.print(F(" | CLT: ")); Serial.print(clt); Serial.print(F("C"));
+    Serial.print(F(" | IAT: ")); Serial.print(iat); Serial.print(F("C"));
+    Serial.print(F(" | BAT: ")); Serial.print(bat); Serial.println(F("V"));
 }
 
 static inline bool isAsciiPrintable(uint8_t b) { return (b >= 32 && b <= 126) || b == '\t' || b == '\r' || b == '\n'; }
@@ -175,7 +179,7 @@ void readAndProcess() {
         if (ok) { printDebug(); return; }
     }
     // Fallback: print hex dump
-    Serial.print("HEX "); Serial.print(idx); Serial.print(" bytes: ");
+    Serial.print(F("HEX ")); Serial.print(idx); Serial.print(F(" bytes: "));
     for (int i=0;i<idx;i++){ if (buf[i] < 16) Serial.print('0'); Serial.print(buf[i], HEX); Serial.print(' ');} Serial.println();
 }
 
@@ -196,8 +200,8 @@ void setup() {
     Serial.begin(115200);
     Serial1.begin(115200);
     delay(1000);
-    Serial.println("=== MODE DEBUG DIMULAI ===");
-    Serial.println("Mengirim perintah 'A' ke Speeduino...");
+    Serial.println(F("=== MODE DEBUG DIMULAI ==="));
+    Serial.println(F("Mengirim perintah 'A' ke Speeduino..."));
 }
 
 void loop() {
@@ -210,18 +214,18 @@ void loop() {
 
     int jumlahData = Serial1.available();
     if (jumlahData > 0) {
-        Serial.print("Diterima ");
+        Serial.print(F("Diterima "));
         Serial.print(jumlahData);
-        Serial.print(" bytes: ");
+        Serial.print(F(" bytes: "));
         while (Serial1.available() > 0) {
             byte dataMentah = Serial1.read();
-            if (dataMentah < 16) Serial.print("0");
+            if (dataMentah < 16) Serial.print(F("0"));
             Serial.print(dataMentah, HEX);
-            Serial.print(" ");
+            Serial.print(F(" "));
         }
         Serial.println();
     } else {
-        Serial.println("MENUNGGU... Tidak ada respon dari Speeduino (Cek Kabel RX/TX!)");
+        Serial.println(F("MENUNGGU... Tidak ada respon dari Speeduino (Cek Kabel RX/TX!)"));
     }
     delay(500);
 }
@@ -231,12 +235,48 @@ void loop() {
 // GLOBAL OBJECTS
 // ============================================================================
 
-ECUData ecu_data;                           // Engine data container
+ECUData ecu_work;                           // Parser's working copy (producer)
+ECUSnapshot ecu_snapshot;                   // Published frames (seqlock double buffer)
+ECUData ecu_data;                           // Consumer snapshot (sync, UI)
 SpeeduinoParser parser(SERIAL_BAUD);        // Speeduino serial parser
 SyncManager sync_manager;                   // Sync loss & recovery state machine
 DisplayManager display;                     // TFT display driver
 UIStateMachine ui_state_machine;            // UI state & dirty flag management
 UIScreen ui_screen(display);                // UI renderer
+SessionHistory session_history;             // Compressed RPM/MAP/CLT/AFR history
+SessionStats session_stats;                 // Per-channel min/max/mean/variance
+DerivedChannels derived;                    // Lazy duty / fuel flow / lambda / litres
+
+#ifdef ARDUINO_AVR_MEGA2560
+// AFR limits over RPM x MAP (AFR x100). Turbo example: lean is fine at idle
+// and cruise, but the lean limit tightens hard under boost. Uno: scalar only.
+// The tables are constant-initialized (constexpr sources are not kept), so
+// RAM holds only the two Table2D objects.
+static constexpr uint16_t AFR_RPM_AXIS[8] = { 800, 1500, 2500, 3500, 4500, 5500, 6500, 7500 };
+static constexpr uint16_t AFR_MAP_AXIS[8] = { 30, 60, 90, 110, 140, 170, 200, 250 };
+static constexpr int16_t AFR_MIN_VALUES[8][8] = {
+    { 1150, 1150, 1150, 1150, 1150, 1150, 1150, 1150 },
+    { 1150, 1150, 1150, 1150, 1150, 1150, 1150, 1150 },
+    { 1100, 1100, 1100, 1100, 1100, 1100, 1100, 1100 },
+    { 1050, 1050, 1050, 1050, 1050, 1050, 1050, 1050 },
+    { 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 },
+    { 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 },
+    { 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 },
+    { 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 },
+};
+static constexpr int16_t AFR_MAX_VALUES[8][8] = {
+    { 1750, 1750, 1750, 1700, 1700, 1650, 1650, 1650 },
+    { 1700, 1700, 1700, 1650, 1650, 1600, 1600, 1600 },
+    { 1600, 1600, 1550, 1500, 1450, 1400, 1400, 1400 },
+    { 1500, 1450, 1400, 1350, 1300, 1300, 1300, 1300 },
+    { 1400, 1350, 1300, 1280, 1250, 1250, 1250, 1250 },
+    { 1350, 1300, 1250, 1230, 1200, 1200, 1200, 1200 },
+    { 1300, 1250, 1220, 1200, 1180, 1180, 1180, 1180 },
+    { 1300, 1250, 1200, 1180, 1150, 1150, 1150, 1150 },
+};
+SyncManager::AfrTable afr_min_table(AFR_RPM_AXIS, AFR_MAP_AXIS, AFR_MIN_VALUES);
+SyncManager::AfrTable afr_max_table(AFR_RPM_AXIS, AFR_MAP_AXIS, AFR_MAX_VALUES);
+#endif
 
 // ============================================================================
 // SYSTEM STATE
@@ -251,6 +291,48 @@ enum class SystemState {
 };
 
 SystemState system_state = SystemState::BOOT;
+
+// ============================================================================
+// RAM BUDGET
+// ============================================================================
+
+// Static RAM: printRamReport() at boot gives .data + .bss (same figure as
+// avr-size) and the big objects; the status dump prints stack headroom
+#if defined(__AVR__)
+extern char __data_start;
+extern char __bss_end;
+extern char __heap_start;
+extern char *__brkval;
+// Gap between heap end and stack pointer = stack headroom right now
+static int freeRam() {
+    char top;
+    return (int)(&top - (__brkval ? __brkval : &__heap_start));
+}
+static int staticRam() { return (int)(&__bss_end - &__data_start); }
+#else
+static int freeRam() { return -1; }
+static int staticRam() { return -1; }
+#endif
+
+// Labels are F() strings, so the report itself costs no SRAM
+void printRamReport() {
+    Serial.println(F("[RAM] Budget (bytes):"));
+    Serial.print(F("  Static .data+.bss: ")); Serial.println(staticRam());
+    Serial.print(F("  ECUData x2 + ECUSnapshot: ")); Serial.println(sizeof(ECUData) * 2 + sizeof(ECUSnapshot));
+    Serial.print(F("  SpeeduinoParser: ")); Serial.println(sizeof(SpeeduinoParser));
+    Serial.print(F("  UIScreen: ")); Serial.println(sizeof(UIScreen));
+    Serial.print(F("  SyncManager: ")); Serial.println(sizeof(SyncManager));
+    Serial.print(F("  UIStateMachine: ")); Serial.println(sizeof(UIStateMachine));
+    Serial.print(F("  DisplayManager: ")); Serial.println(sizeof(DisplayManager));
+    Serial.print(F("  SessionHistory: ")); Serial.println(sizeof(SessionHistory));
+    Serial.print(F("  SessionStats: ")); Serial.println(sizeof(SessionStats));
+    Serial.print(F("  DerivedChannels: ")); Serial.println(sizeof(DerivedChannels));
+    #ifdef ARDUINO_AVR_MEGA2560
+    Serial.print(F("  AFR tables: ")); Serial.println(sizeof(SyncManager::AfrTable) * 2);
+    #endif
+    Serial.print(F("  Free (stack headroom): ")); Serial.println(freeRam());
+}
+
 uint32_t last_render_time = 0;
 uint32_t last_debug_time = 0;
 const uint32_t RENDER_INTERVAL_MS = 75;    // ~13 Hz update rate (steadier)
@@ -265,14 +347,14 @@ void setup() {
     Serial.begin(115200);
     delay(1000);  // Wait for serial monitor
     
-    Serial.println("\n========================================");
-    Serial.println("  CARVIONICS EFIS - BOOT SEQUENCE");
-    Serial.println("========================================\n");
+    Serial.println(F("\n========================================"));
+    Serial.println(F("  CARVIONICS EFIS - BOOT SEQUENCE"));
+    Serial.println(F("========================================\n"));
     
     // Initialize display
-    Serial.print("Initializing TFT display...");
+    Serial.print(F("Initializing TFT display..."));
     if (display.begin()) {
-        Serial.println(" OK");
+        Serial.println(F(" OK"));
         display.fillScreen(DisplayManager::Color::BLACK);
         // Quick visual check: draw RGB bars then clear
         display.drawTestPattern();
@@ -280,7 +362,7 @@ void setup() {
         display.clear();
         system_state = SystemState::DISPLAY_INIT;
     } else {
-        Serial.println(" FAILED");
+        Serial.println(F(" FAILED"));
         system_state = SystemState::ERROR;
         return;
     }
@@ -289,40 +371,58 @@ void setup() {
     display.setTextSize(1);
     display.setTextColor(DisplayManager::Color::GREEN, DisplayManager::Color::BLACK);
     display.setCursor(100, 100);
-    display.print("INITIALIZING...");
+    display.print(F("INITIALIZING..."));
     
     // Initialize serial parser
-    Serial.print("Initializing Speeduino parser (baud=");
+    Serial.print(F("Initializing Speeduino parser (baud="));
     Serial.print(SERIAL_BAUD);
-    Serial.println(")...");
+    Serial.println(F(")..."));
     #ifdef ARDUINO_AVR_MEGA2560
     #ifdef USE_ECU_SERIAL3
     parser.begin(Serial3);  // Use Serial3 for Speeduino on Mega (optional)
-    Serial.println("[Serial] Listening on Serial3 (RX3/PIN 15)");
+    Serial.println(F("[Serial] Listening on Serial3 (RX3/PIN 15)"));
     #elif defined(USE_ECU_SERIAL0)
     parser.begin(Serial);   // Use Serial0 (USB UART) for Speeduino on Mega
-    Serial.println("[Serial] Listening on Serial0 (RX0/PIN 0) — may conflict with USB");
+    Serial.println(F("[Serial] Listening on Serial0 (RX0/PIN 0) — may conflict with USB"));
     #else
     parser.begin(Serial1);  // Use Serial1 for Speeduino on Mega
-    Serial.println("[Serial] Listening on Serial1 (RX1/PIN 19)");
+    Serial.println(F("[Serial] Listening on Serial1 (RX1/PIN 19)"));
     #endif
     #else
     parser.begin(Serial);   // Use Serial for Speeduino on Uno (shared with Serial Monitor)
-    Serial.println("[Serial] Listening on Serial (UNO RX0/PIN 0)");
+    Serial.println(F("[Serial] Listening on Serial (UNO RX0/PIN 0)"));
+    #endif
+    #ifndef ECU_BAUD_FIXED
+    Serial.print(F("[Serial] Baud autodetect, starting at "));
+    Serial.println(parser.getBaudRate());
     #endif
-    Serial.println(" OK");
+    Serial.println(F(" OK"));
 
     // Primary request mode (active polling)
     #ifdef USE_PRIMARY_REQUEST
-    Serial.print("[PrimaryRQ] Enabled: cmd=");
+    Serial.print(F("[PrimaryRQ] Enabled: cmd="));
     Serial.print((char)PRIMARY_REQ_CMD);
-    Serial.print(" (0x"); Serial.print((uint8_t)PRIMARY_REQ_CMD, HEX); Serial.print(") period=");
+    Serial.print(F(" (0x")); Serial.print((uint8_t)PRIMARY_REQ_CMD, HEX); Serial.print(F(") period="));
     Serial.print((uint32_t)PRIMARY_REQ_PERIOD_MS);
-    Serial.println(" ms");
+    Serial.println(F(" ms"));
     parser.configureRequest((uint8_t)PRIMARY_REQ_CMD, (uint32_t)PRIMARY_REQ_PERIOD_MS);
-    Serial.println("[PrimaryRQ] TX pin must connect to ECU RX; RX pin to ECU TX; GND common");
+    // With cmd 'r' only the bytes of the displayed/monitored channels are read
+    parser.setRequestedChannels(ui_screen.requiredChannels() | sync_manager.monitoredChannels() |
+                                DerivedChannels::requiredChannels());
+    if ((uint8_t)PRIMARY_REQ_CMD == SpeeduinoParser::SELECTIVE_READ_CMD) {
+        Serial.print(F("[PrimaryRQ] Selective read: offset="));
+        Serial.print(parser.getReadOffset());
+        Serial.print(F(" length="));
+        Serial.println(parser.getReadLength());
+    }
+    Serial.println(F("[PrimaryRQ] TX pin must connect to ECU RX; RX pin to ECU TX; GND common"));
     #endif
     
+    // Derived channels need PW1 (extended block) besides RPM/AFR; the
+    // parser decodes by the working copy's subscriptions
+    ecu_work.subscribe(DerivedChannels::requiredChannels());
+    ui_screen.attachDerived(&derived);
+
     // Set default thresholds
     SyncManager::Thresholds thresholds;
     thresholds.rpm_max = 8000;
@@ -335,17 +435,25 @@ void setup() {
     // Tweaked to reduce flicker/state flapping
     thresholds.data_timeout_ms = 700;
     thresholds.recovery_delay_ms = 2500;
+    // Trend limits keep their Thresholds defaults (above the noise floors)
     sync_manager.setThresholds(thresholds);
+    sync_manager.attachLink(&parser.getLinkQuality());
+    #ifdef ARDUINO_AVR_MEGA2560
+    sync_manager.setAfrTables(&afr_min_table, &afr_max_table);
+    #endif
     
     system_state = SystemState::RUNNING;
-    
-    Serial.println("\n[SYSTEM] Boot sequence complete - RUNNING");
-    Serial.println("Waiting for Speeduino data...\n");
+    printRamReport();
+
+    Serial.println(F("\n[SYSTEM] Boot sequence complete - RUNNING"));
+    Serial.println(F("Waiting for Speeduino data...\n"));
     
     // Initialize UI state machine mengikuti state awal SyncManager (NO_DATA)
     ui_state_machine.update(sync_manager.getState());
 }
 
+void handleSerialCommand();
+
 // ============================================================================
 // ARDUINO LOOP
 // ============================================================================
@@ -354,13 +462,37 @@ void loop() {
     uint32_t now = millis();
     
     // ========== PARSER UPDATE ==========
-    // Non-blocking serial read & frame parsing
-    parser.update(ecu_data);
+    // Non-blocking serial read & frame parsing into the producer copy;
+    // only complete frames (or a sync loss) are published to consumers
+    uint32_t sync_losses = parser.getSyncLosses();
+    bool decoded = parser.update(ecu_work);
+    if (decoded || parser.getSyncLosses() != sync_losses) {
+        ecu_snapshot.publish(ecu_work);
+    }
+    if (ecu_snapshot.read(ecu_data)) {
+        // A sync loss republishes the last frame: count it only once
+        if (decoded) session_stats.update(ecu_data);
+        derived.observe(ecu_data);
+    }
+    session_history.update(ecu_data);
     
     // ========== SYNC MANAGER UPDATE ==========
     // Evaluate thresholds & state transitions
     sync_manager.update(ecu_data);
     
+    // ========== PEAK RECALL ==========
+    // Engine stopped after a run: session summary until it turns again
+    static bool engine_running = false;
+    bool running = ecu_data.isDataValid && ecu_data.rpm > 0;
+    if (running != engine_running) {
+        engine_running = running;
+        if (!running && session_stats.samples()) {
+            ui_screen.showPeakRecall(&session_stats);
+        } else if (running && ui_screen.isPeakRecall()) {
+            ui_screen.showPeakRecall(nullptr);
+        }
+    }
+    
     // ========== UI STATE MACHINE UPDATE ==========
     // Orchestrate rendering (dirty flags)
     ui_state_machine.update(sync_manager.getState());
@@ -370,30 +502,38 @@ void loop() {
     if (now - last_render_time >= RENDER_INTERVAL_MS) {
         last_render_time = now;
         
-        // Main rendering function
-        // Dirty flags prevent unnecessary redraws
-        ui_screen.render(ecu_data, sync_manager, ui_state_machine);
-        
-        // Mark all slices as clean (for next iteration)
-        // In next iteration, only changed slices will be redrawn
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::HEADER);
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::RPM_FIELD);
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::ENGINE_CORE);
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::CONTROL_DATA);
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::FOOTER);
-        ui_state_machine.markSliceClean(UIStateMachine::UISlice::FULL_SCREEN);
+        // Changed channels and link flags bump the widget generations
+        ui_state_machine.noteData(ecu_data);
+
+        // Main rendering function: only dirty widgets are touched
+        UIStateMachine::WidgetMask drawn = ui_screen.render(ecu_data, sync_manager, ui_state_machine);
+
+        // Widgets the renderer brought up to date are clean; widgets hidden
+        // behind a full page stay dirty until the grid comes back
+        ui_state_machine.markDrawn(drawn);
+
+        // Sync and smoothing have seen this batch of changed channels
+        ecu_data.clearChanged();
     }
     
+    // ========== CONSOLE COMMANDS ==========
+    // Only when USB Serial is not the ECU link (Uno / USE_ECU_SERIAL0 share it)
+#if defined(ARDUINO_AVR_MEGA2560) && !defined(USE_ECU_SERIAL0)
+    handleSerialCommand();
+#endif
+
     // ========== DEBUG OUTPUT ==========
     // Print statistics every 5 seconds
     if (now - last_debug_time >= DEBUG_INTERVAL_MS) {
         last_debug_time = now;
         
-        Serial.println("\n========== SYSTEM STATUS ==========");
+        Serial.println(F("\n========== SYSTEM STATUS =========="));
         ecu_data.debugPrint();
         parser.debugPrint();
+        parser.getLinkQuality().debugPrint();
         sync_manager.debugPrint();
-        Serial.println("===================================\n");
+        Serial.print(F("Free RAM: ")); Serial.println(freeRam());
+        Serial.println(F("===================================\n"));
     }
     
     // Very short delay to prevent watchdog timeout
@@ -411,36 +551,77 @@ void handleSerialCommand() {
     
     switch (cmd) {
         case 'd':  // Debug toggle
-            Serial.println("[CMD] Debug info requested");
+            Serial.println(F("[CMD] Debug info requested"));
             ecu_data.debugPrint();
             break;
         
         case 'r':  // Reset data
-            Serial.println("[CMD] Resetting ECU data");
-            ecu_data.reset();
+            Serial.println(F("[CMD] Resetting ECU data"));
+            ecu_work.reset();
+            ecu_snapshot.publish(ecu_work);
             break;
         
         case 's':  // Trigger sync loss
-            Serial.println("[CMD] Triggering sync loss");
+            Serial.println(F("[CMD] Triggering sync loss"));
             sync_manager.triggerSyncLoss();
             break;
         
         case 'c':  // Clear screen
-            Serial.println("[CMD] Clearing display");
+            Serial.println(F("[CMD] Clearing display"));
             display.clear();
             break;
+
+        case 'a':  // Acknowledge latched alarms
+            Serial.println(F("[CMD] Alarms acknowledged"));
+            sync_manager.acknowledgeAlarms();
+            break;
+
+        case 'p':  // Session statistics
+            session_stats.dump(Serial);
+            break;
+        
+        case 'z':  // Reset session statistics
+            Serial.println(F("[CMD] Session stats cleared"));
+            session_stats.reset();
+            break;
+        
+        case 'f':  // Derived channels
+            Serial.print(F("[CMD] Duty: ")); Serial.print(derived.get(DerivedChannels::Id::INJ_DUTY) / 10.0, 1);
+            Serial.print(F("% Flow: ")); Serial.print(derived.get(DerivedChannels::Id::FUEL_FLOW) / 100.0, 2);
+            Serial.print(F(" L/h Lambda: ")); Serial.print(derived.get(DerivedChannels::Id::LAMBDA) / 1000.0, 3);
+            Serial.print(F(" Used: ")); Serial.print(derived.get(DerivedChannels::Id::FUEL_USED) / 100.0, 2);
+            Serial.print(F(" L (evals ")); Serial.print(derived.getEvaluations());
+            if (derived.getFuelGapMs()) { Serial.print(F(", gaps ")); Serial.print(derived.getFuelGapMs() / 1000); Serial.print(F(" s not counted")); }
+            Serial.println(F(")"));
+            break;
+
+        case 'u':  // Reset fuel used
+            Serial.println(F("[CMD] Fuel used reset"));
+            derived.resetFuelUsed();
+            break;
+
+        case 'h':  // History export
+            Serial.println(F("[CMD] History CSV"));
+            session_history.exportCsv(Serial);
+            break;
         
         case '?':  // Help
-            Serial.println("\n=== COMMANDS ===");
-            Serial.println("d - Debug info");
-            Serial.println("r - Reset data");
-            Serial.println("s - Trigger sync loss");
-            Serial.println("c - Clear screen");
-            Serial.println("? - This help");
+            Serial.println(F("\n=== COMMANDS ==="));
+            Serial.println(F("d - Debug info"));
+            Serial.println(F("r - Reset data"));
+            Serial.println(F("s - Trigger sync loss"));
+            Serial.println(F("c - Clear screen"));
+            Serial.println(F("a - Acknowledge latched alarms"));
+            Serial.println(F("p - Session stats (min/max/mean)"));
+            Serial.println(F("z - Reset session stats"));
+            Serial.println(F("f - Derived channels (duty/flow/lambda/fuel)"));
+            Serial.println(F("u - Reset fuel used"));
+            Serial.println(F("h - Export history (CSV)"));
+            Serial.println(F("? - This help"));
             break;
         
         default:
-            Serial.print("Unknown command: ");
+            Serial.print(F("Unknown command: "));
             Serial.println(cmd);
     }
 }
@@ -0,0 +1,112 @@
+// Host benchmark: fixed-point scanner vs the previous float-based parsing.
+// Run with: pio test -e native -f bench_fixed_point
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "FixedPoint.h"
+
+// Previous implementation (toFloat/toInt lambdas), kept as the reference
+static float legacyToFloat(const char *s) {
+    while (*s == ' ' || *s == '\t') s++;
+    bool neg = false;
+    if (*s == '-') { neg = true; s++; }
+    int32_t ip = 0; int32_t fp = 0; int32_t div = 1;
+    while (*s >= '0' && *s <= '9') { ip = ip * 10 + (*s - '0'); s++; }
+    if (*s == '.') { s++; while (*s >= '0' && *s <= '9') { fp = fp * 10 + (*s - '0'); div *= 10; s++; } }
+    float v = (float)ip + (fp ? (float)fp / (float)div : 0.0f);
+    return neg ? -v : v;
+}
+
+static int32_t legacyToInt(const char *s) {
+    bool neg = false;
+    int32_t val = 0;
+    while (*s == ' ' || *s == '\t') s++;
+    if (*s == '-') { neg = true; s++; }
+    while (*s >= '0' && *s <= '9') { val = val * 10 + (*s - '0'); s++; }
+    return neg ? -val : val;
+}
+
+static uint16_t legacyAfr100(const char *s) {
+    float f = legacyToFloat(s);
+    if (f > 0.0f && f < 50.0f) return (uint16_t)(f * 100.0f + 0.5f);
+    return (uint16_t)legacyToInt(s);
+}
+
+static uint16_t legacyBatteryMv(const char *s) {
+    float f = legacyToFloat(s);
+    if (f > 0.0f && f < 30.0f) return (uint16_t)(f * 1000.0f + 0.5f);
+    int32_t bi = legacyToInt(s);
+    if (bi >= 0 && bi <= 160) return (uint16_t)(bi * 100);
+    return (uint16_t)bi;
+}
+
+static uint16_t fixedAfr100(const char *s) {
+    fixp::Decimal d;
+    fixp::scan(s, d);
+    return (uint16_t)(fixp::inOpenRange(d, 50) ? fixp::scaled<100>(d) : d.whole);
+}
+
+static uint16_t fixedBatteryMv(const char *s) {
+    fixp::Decimal d;
+    fixp::scan(s, d);
+    if (fixp::inOpenRange(d, 30)) return (uint16_t)fixp::scaled<1000>(d);
+    int32_t bi = d.whole;
+    if (bi >= 0 && bi <= 160) return (uint16_t)(bi * 100);
+    return (uint16_t)bi;
+}
+
+static const char *const AFR_SAMPLES[] = {
+    "14.7", "14.70", " 13.25", "9.9", "22.0", "1470", "1325", "0.5", "49.99", "11.005"
+};
+static const char *const BAT_SAMPLES[] = {
+    "12.6", "13.85", " 14.2", "0.9", "29.999", "126", "138", "12600", "11.8", "7"
+};
+static const uint8_t SAMPLE_COUNT = sizeof(AFR_SAMPLES) / sizeof(AFR_SAMPLES[0]);
+
+void test_fixed_matches_legacy() {
+    for (uint8_t i = 0; i < SAMPLE_COUNT; ++i) {
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(legacyAfr100(AFR_SAMPLES[i]), fixedAfr100(AFR_SAMPLES[i]), AFR_SAMPLES[i]);
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(legacyBatteryMv(BAT_SAMPLES[i]), fixedBatteryMv(BAT_SAMPLES[i]), BAT_SAMPLES[i]);
+    }
+}
+
+void test_scan_stops_at_delimiter() {
+    fixp::Decimal d;
+    const char *end = fixp::scan("-12.345678,99", d);
+    TEST_ASSERT_EQUAL_CHAR(',', *end);
+    TEST_ASSERT_TRUE(d.valid && d.neg);
+    TEST_ASSERT_EQUAL_INT32(-12345, fixp::scaled<1000>(d));
+    TEST_ASSERT_EQUAL_INT32(-1235, fixp::scaled<100>(d));
+}
+
+template <typename F>
+static double nsPerCall(F fn, volatile uint32_t &sink) {
+    const uint32_t ROUNDS = 200000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < ROUNDS; ++r) {
+        for (uint8_t i = 0; i < SAMPLE_COUNT; ++i) sink += fn(i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)ROUNDS * SAMPLE_COUNT);
+}
+
+void test_bench_fixed_vs_float() {
+    volatile uint32_t sink = 0;
+    double legacy = nsPerCall([](uint8_t i) -> uint32_t {
+        return legacyAfr100(AFR_SAMPLES[i]) + legacyBatteryMv(BAT_SAMPLES[i]);
+    }, sink);
+    double fixed = nsPerCall([](uint8_t i) -> uint32_t {
+        return fixedAfr100(AFR_SAMPLES[i]) + fixedBatteryMv(BAT_SAMPLES[i]);
+    }, sink);
+    // Host FPUs hide most of the gap; on the ATmega2560 float is emulated
+    // in software, so the AVR saving is larger than the ratio shown here.
+    printf("AFR+battery parse: float %.1f ns, fixed %.1f ns (x%.2f)\n", legacy, fixed, legacy / fixed);
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_matches_legacy);
+    RUN_TEST(test_scan_stops_at_delimiter);
+    RUN_TEST(test_bench_fixed_vs_float);
+    return UNITY_END();
+}
@@ -12,19 +12,13 @@ static DisplayManager display;
 static UIStateMachine uiState;
 static UIScreen screen(display);
 
-static void markAllClean() {
-    uiState.markSliceClean(UIStateMachine::UISlice::HEADER);
-    uiState.markSliceClean(UIStateMachine::UISlice::RPM_FIELD);
-    uiState.markSliceClean(UIStateMachine::UISlice::ENGINE_CORE);
-    uiState.markSliceClean(UIStateMachine::UISlice::CONTROL_DATA);
-    uiState.markSliceClean(UIStateMachine::UISlice::FOOTER);
-    uiState.markSliceClean(UIStateMachine::UISlice::FULL_SCREEN);
-}
+using Ch = ECUData::Channel;
 
 static void renderTick(uint16_t ms = 50) {
     uiState.update(syncMgr.getState());
-    screen.render(ecu, syncMgr, uiState);
-    markAllClean();
+    uiState.noteData(ecu);
+    uiState.markDrawn(screen.render(ecu, syncMgr, uiState));
+    ecu.clearChanged();
     delay(ms);
 }
 
@@ -55,16 +49,16 @@ void test_ui_demo_sequence() {
     // === ANIMATED DEMO: semua nilai bergerak dinamis ===
     ecu.isSynced = true;
     ecu.isDataValid = true;
-    ecu.battery = 13900;
+    ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)13900);
     
     // Siklus 1: Idle → cruising (NORMAL)
     for (int i = 0; i < 30; i++) {
-        ecu.rpm = 900 + i * 50;           // 900 → 2400 rpm
-        ecu.map = 30 + i * 1;             // 30 → 60 kPa
-        ecu.clt = 70 + i * 0.5;           // 70 → 85°C
-        ecu.iat = 25 + i * 0.3;           // 25 → 34°C
-        ecu.afr = 1450 - i * 2;           // 14.5 → 13.9
-        ecu.tps = 2 + i * 1;              // 2 → 32%
+        ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)(900 + i * 50));            // 900 → 2400 rpm
+        ecu.store(Ch::MAP, &ECUData::map, (uint16_t)(30 + i * 1));              // 30 → 60 kPa
+        ecu.store(Ch::CLT, &ECUData::clt, (int16_t)(70 + i * 0.5));             // 70 → 85°C
+        ecu.store(Ch::IAT, &ECUData::iat, (int16_t)(25 + i * 0.3));             // 25 → 34°C
+        ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)(1450 - i * 2));            // 14.5 → 13.9
+        ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)(2 + i * 1));               // 2 → 32%
         ecu.lastUpdateMillis = millis();
         syncMgr.update(ecu);
         renderTick(100);
@@ -72,13 +66,13 @@ void test_ui_demo_sequence() {
     
     // Siklus 2: Heavy load → overheat (CAUTION/WARNING)
     for (int i = 0; i < 40; i++) {
-        ecu.rpm = 2400 + i * 100;         // 2400 → 6400 rpm
-        ecu.map = 60 + i * 2;             // 60 → 140 kPa
-        ecu.clt = 85 + i * 0.7;           // 85 → 113°C (WARNING!)
-        ecu.iat = 34 + i * 0.5;           // 34 → 54°C
-        ecu.afr = 1390 - i * 5;           // 13.9 → 11.9 (RICH!)
-        ecu.tps = 32 + i * 1.5;           // 32 → 92%
-        ecu.battery = 13900 - i * 30;     // voltage drop
+        ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)(2400 + i * 100));          // 2400 → 6400 rpm
+        ecu.store(Ch::MAP, &ECUData::map, (uint16_t)(60 + i * 2));              // 60 → 140 kPa
+        ecu.store(Ch::CLT, &ECUData::clt, (int16_t)(85 + i * 0.7));             // 85 → 113°C (WARNING!)
+        ecu.store(Ch::IAT, &ECUData::iat, (int16_t)(34 + i * 0.5));             // 34 → 54°C
+        ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)(1390 - i * 5));            // 13.9 → 11.9 (RICH!)
+        ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)(32 + i * 1.5));            // 32 → 92%
+        ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)(13900 - i * 30));  // voltage drop
         ecu.lastUpdateMillis = millis();
         syncMgr.update(ecu);
         renderTick(100);
@@ -86,13 +80,13 @@ void test_ui_demo_sequence() {
     
     // Siklus 3: Decel → idle (recovery)
     for (int i = 0; i < 35; i++) {
-        ecu.rpm = 6400 - i * 150;         // 6400 → 1150 rpm
-        ecu.map = 140 - i * 3;            // 140 → 35 kPa
-        ecu.clt = 113 - i * 0.8;          // 113 → 85°C (cooling)
-        ecu.iat = 54 - i * 0.6;           // 54 → 33°C
-        ecu.afr = 1190 + i * 8;           // 11.9 → 14.7 (LEAN!)
-        ecu.tps = 92 - i * 2.5;           // 92 → 4%
-        ecu.battery = 12700 + i * 20;     // voltage recover
+        ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)(6400 - i * 150));          // 6400 → 1150 rpm
+        ecu.store(Ch::MAP, &ECUData::map, (uint16_t)(140 - i * 3));             // 140 → 35 kPa
+        ecu.store(Ch::CLT, &ECUData::clt, (int16_t)(113 - i * 0.8));            // 113 → 85°C (cooling)
+        ecu.store(Ch::IAT, &ECUData::iat, (int16_t)(54 - i * 0.6));             // 54 → 33°C
+        ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)(1190 + i * 8));            // 11.9 → 14.7 (LEAN!)
+        ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)(92 - i * 2.5));            // 92 → 4%
+        ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)(12700 + i * 20));  // voltage recover
         ecu.lastUpdateMillis = millis();
         syncMgr.update(ecu);
         renderTick(80);
@@ -100,12 +94,12 @@ void test_ui_demo_sequence() {
     
     // Siklus 4: Fluctuation at idle (NORMAL)
     for (int i = 0; i < 25; i++) {
-        ecu.rpm = 900 + (i % 5) * 20;     // 900±100 rpm oscillation
-        ecu.map = 35 + (i % 3) * 2;       // 35±6 kPa
-        ecu.clt = 85 + (i % 4);           // stable CLT
-        ecu.iat = 30 + (i % 2);           // stable IAT
-        ecu.afr = 1450 + (i % 5) * 5;     // 14.5±0.25 afr
-        ecu.tps = 2 + (i % 2);            // idle TPS
+        ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)(900 + (i % 5) * 20));      // 900±100 rpm oscillation
+        ecu.store(Ch::MAP, &ECUData::map, (uint16_t)(35 + (i % 3) * 2));        // 35±6 kPa
+        ecu.store(Ch::CLT, &ECUData::clt, (int16_t)(85 + (i % 4)));             // stable CLT
+        ecu.store(Ch::IAT, &ECUData::iat, (int16_t)(30 + (i % 2)));             // stable IAT
+        ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)(1450 + (i % 5) * 5));      // 14.5±0.25 afr
+        ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)(2 + (i % 2)));             // idle TPS
         ecu.lastUpdateMillis = millis();
         syncMgr.update(ecu);
         renderTick(150);
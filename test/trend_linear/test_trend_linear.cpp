@@ -0,0 +1,75 @@
+// Host tests for the O(1) least-squares trend (include/Trend.h).
+// Run with: pio test -e native -f trend_linear
+#include <unity.h>
+#include "Trend.h"
+
+typedef LinearTrend<16, 1000> Trend16;   // Mega: 16 samples, 1 s apart
+typedef LinearTrend<8, 2000> Trend8;     // Uno: 8 samples, 2 s apart
+
+// Ramp: the fit is exact, also after the window has slid many times
+void test_ramp_slope_and_projection() {
+    Trend16 t;
+    for (int16_t i = 0; i < 100; ++i) {
+        t.push((int16_t)(20 + i / 2));    // +0.5 unit/s, integer steps
+    }
+    // Half-unit staircase: slope 30/min within the rounding of the steps
+    TEST_ASSERT_INT32_WITHIN(2, 30, t.perMinute());
+
+    Trend16 r;
+    for (int16_t i = 0; i < 40; ++i) r.push((int16_t)(1000 + 10 * i));   // +10/s
+    TEST_ASSERT_EQUAL_INT32(600, r.perMinute());
+    // Newest = 1390; 1500 is 110 units = 11 s away, 1000 is behind
+    TEST_ASSERT_EQUAL_INT32(11, r.secondsTo(1500));
+    TEST_ASSERT_EQUAL_INT32(-1, r.secondsTo(1000));
+
+    Trend8 u;
+    for (int16_t i = 0; i < 20; ++i) u.push((int16_t)(14000 - 40 * i));  // -20/s
+    TEST_ASSERT_EQUAL_INT32(-1200, u.perMinute());
+    // Newest = 13240; 11000 is 2240 units = 112 s away
+    TEST_ASSERT_EQUAL_INT32(112, u.secondsTo(11000));
+}
+
+// Step of one LSB: the slope stays bounded while the step crosses the
+// window (this sets CLT_TREND_NOISE / BATTERY_TREND_NOISE) and returns to
+// zero once the window is flat again
+void test_step_is_bounded_and_clears() {
+    int32_t worst16 = 0, worst8 = 0;
+    Trend16 t;
+    Trend8 u;
+    for (int16_t i = 0; i < 40; ++i) {
+        int16_t y = i < 20 ? 13900 : 14000;  // 0.1 V step on the battery byte
+        t.push(y);
+        u.push(y);
+        if (t.full()) {
+            int32_t s = t.perMinute();
+            if ((s < 0 ? -s : s) > worst16) worst16 = s < 0 ? -s : s;
+        }
+        if (u.full()) {
+            int32_t s = u.perMinute();
+            if ((s < 0 ? -s : s) > worst8) worst8 = s < 0 ? -s : s;
+        }
+    }
+    TEST_ASSERT_TRUE(worst16 > 0 && worst16 < 600);
+    TEST_ASSERT_TRUE(worst8 > 0 && worst8 < 600);
+    TEST_ASSERT_EQUAL_INT32(0, t.perMinute());
+    TEST_ASSERT_EQUAL_INT32(0, u.perMinute());
+    TEST_ASSERT_EQUAL_INT32(-1, t.secondsTo(15000));
+}
+
+void test_not_full_until_window() {
+    Trend8 u;
+    for (int16_t i = 0; i < 7; ++i) u.push(i);
+    TEST_ASSERT_FALSE(u.full());
+    u.push(7);
+    TEST_ASSERT_TRUE(u.full());
+    u.clear();
+    TEST_ASSERT_FALSE(u.full());
+}
+
+int main(int, char **) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ramp_slope_and_projection);
+    RUN_TEST(test_step_is_bounded_and_clears);
+    RUN_TEST(test_not_full_until_window);
+    return UNITY_END();
+}
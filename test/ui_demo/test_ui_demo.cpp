@@ -12,22 +12,26 @@ static DisplayManager display;
 static UIStateMachine uiState;
 static UIScreen screen(display);
 
-static void markAllClean() {
-    uiState.markSliceClean(UIStateMachine::UISlice::HEADER);
-    uiState.markSliceClean(UIStateMachine::UISlice::RPM_FIELD);
-    uiState.markSliceClean(UIStateMachine::UISlice::ENGINE_CORE);
-    uiState.markSliceClean(UIStateMachine::UISlice::CONTROL_DATA);
-    uiState.markSliceClean(UIStateMachine::UISlice::FOOTER);
-    uiState.markSliceClean(UIStateMachine::UISlice::FULL_SCREEN);
-}
+using Ch = ECUData::Channel;
 
 static void renderTick(uint16_t ms = 50) {
     uiState.update(syncMgr.getState());
-    screen.render(ecu, syncMgr, uiState);
-    markAllClean();
+    uiState.noteData(ecu);
+    uiState.markDrawn(screen.render(ecu, syncMgr, uiState));
+    ecu.clearChanged();  // as loop(): all consumers have seen the changes
     delay(ms);
 }
 
+// Frames keep arriving for ms: alarm debounce and the recovery delay only
+// advance on repeated SyncManager updates
+static void runFrames(uint16_t ms) {
+    for (uint16_t t = 0; t < ms; t += 50) {
+        ecu.lastUpdateMillis = millis();
+        syncMgr.update(ecu);
+        renderTick(50);
+    }
+}
+
 void test_ui_demo_sequence() {
     // Init display
     TEST_ASSERT_TRUE(display.begin());
@@ -53,22 +57,32 @@ void test_ui_demo_sequence() {
     syncMgr.update(ecu);
     renderTick(1200);
 
-    // 4) NORMAL OPERATION
-    ecu.rpm = 2450; ecu.map = 42; ecu.clt = 87; ecu.iat = 31; ecu.afr = 1440; ecu.tps = 3; ecu.battery = 13900;
-    ecu.isSynced = true; ecu.isDataValid = true; ecu.lastUpdateMillis = millis();
-    syncMgr.update(ecu);
-    renderTick(1600);
+    // 4) NORMAL OPERATION (RECOVERY first, then NORMAL after its delay)
+    ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)2450);
+    ecu.store(Ch::MAP, &ECUData::map, (uint16_t)42);
+    ecu.store(Ch::CLT, &ECUData::clt, (int16_t)87);
+    ecu.store(Ch::IAT, &ECUData::iat, (int16_t)31);
+    ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)1440);
+    ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)3);
+    ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)13900);
+    ecu.isSynced = true; ecu.isDataValid = true;
+    runFrames(3000);
+    TEST_ASSERT_TRUE(syncMgr.getState() == SyncManager::SyncState::NORMAL);
 
-    // 5) CAUTION STATE (CLT tinggi / AFR lean)
-    ecu.clt = 97; ecu.afr = 1620; ecu.battery = 13400;
-    syncMgr.update(ecu);
-    renderTick(1600);
+    // 5) CAUTION STATE (AFR lean, inside the caution band)
+    ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)1650);
+    runFrames(1600);
+    TEST_ASSERT_TRUE(syncMgr.getState() == SyncManager::SyncState::CAUTION);
 
-    // 6) WARNING STATE (Overheat / battery drop)
-    ecu.clt = 108; ecu.afr = 1590; ecu.battery = 11800;
-    ecu.rpm = 2600; ecu.map = 55; ecu.tps = 12; ecu.iat = 38;
-    syncMgr.update(ecu);
-    renderTick(1600);
+    // 6) WARNING STATE (overheat / battery drop)
+    ecu.store(Ch::CLT, &ECUData::clt, (int16_t)108);
+    ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)10800);
+    ecu.store(Ch::RPM, &ECUData::rpm, (uint16_t)2600);
+    ecu.store(Ch::MAP, &ECUData::map, (uint16_t)55);
+    ecu.store(Ch::TPS, &ECUData::tps, (uint16_t)12);
+    ecu.store(Ch::IAT, &ECUData::iat, (int16_t)38);
+    runFrames(2500);
+    TEST_ASSERT_TRUE(syncMgr.getState() == SyncManager::SyncState::WARNING);
 
     // 7) SYNC LOSS (FULL OVERRIDE)
     syncMgr.triggerSyncLoss();
@@ -76,12 +90,12 @@ void test_ui_demo_sequence() {
         renderTick(250); // let blink toggle drive FULL_SCREEN redraws
     }
 
-    // 8) RECOVERY → NORMAL
-    ecu.isDataValid = true; ecu.isSynced = true; ecu.lastUpdateMillis = millis();
-    syncMgr.update(ecu); // will go RECOVERY then NORMAL after delay
-    for (int i = 0; i < 10; ++i) {
-        renderTick(200);
-    }
+    // 8) RECOVERY → NORMAL (values back inside the limits)
+    ecu.store(Ch::CLT, &ECUData::clt, (int16_t)88);
+    ecu.store(Ch::AFR, &ECUData::afr, (uint16_t)1450);
+    ecu.store(Ch::BATTERY, &ECUData::battery, (uint16_t)13900);
+    runFrames(4000);
+    TEST_ASSERT_TRUE(syncMgr.getState() == SyncManager::SyncState::NORMAL);
 
     TEST_PASS();
 }